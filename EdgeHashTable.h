@@ -0,0 +1,130 @@
+#ifndef NV_EDGE_HASH_TABLE_H
+#define NV_EDGE_HASH_TABLE_H
+
+#include "HashMix.h"
+#include "Profiler.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Open addressing hash table keyed on an undirected edge, i.e. the (min, max) pair of
+// its vertex indices, so (v0, v1) and (v1, v0) find the same entry.
+// Linear probing into a power of two sized table which is kept at most half full.
+template <typename Value>
+class EdgeHashTable
+{
+public:
+	EdgeHashTable() : numEntries(0), mask(0) {}
+
+	// Sizes the table for about numEdges entries, throwing away anything it holds
+	void Reset(size_t numEdges)
+	{
+		size_t capacity = 16;
+		while(capacity < numEdges * 2)
+			capacity *= 2;
+
+		slots.assign(capacity, Slot{EMPTY_KEY, Value()});
+		numEntries = 0;
+		mask = capacity - 1;
+	}
+
+	Value* Find(int v0, int v1)
+	{
+		if(slots.empty())
+			return nullptr;
+
+		NV_NVTS_PROFILE_COUNT(edgeLookups, 1);
+		NV_NVTS_PROFILE_CHAIN(probes, edgeProbes, maxEdgeProbes);
+
+		std::uint64_t key = MakeKey(v0, v1);
+		for(size_t i = Hash(key) & mask; ; i = (i + 1) & mask)
+		{
+			NV_NVTS_PROFILE_STEP(probes);
+			if(slots[i].key == key)
+				return &slots[i].value;
+			if(slots[i].key == EMPTY_KEY)
+				return nullptr;
+		}
+	}
+
+	const Value* Find(int v0, int v1) const
+	{
+		return const_cast<EdgeHashTable*>(this)->Find(v0, v1);
+	}
+
+	// Adds an edge which must not already be in the table
+	void Insert(int v0, int v1, Value value)
+	{
+		if((numEntries + 1) * 2 > slots.size())
+			Grow();
+
+		std::uint64_t key = MakeKey(v0, v1);
+		size_t i = Hash(key) & mask;
+		while(slots[i].key != EMPTY_KEY)
+		{
+			assert(slots[i].key != key);
+			i = (i + 1) & mask;
+		}
+
+		slots[i].key   = key;
+		slots[i].value = value;
+		++numEntries;
+	}
+
+	size_t Size() const { return numEntries; }
+
+private:
+	// vertex indices are never negative, so this can't be the key of a real edge
+	static constexpr std::uint64_t EMPTY_KEY = ~std::uint64_t{0};
+
+	struct Slot
+	{
+		std::uint64_t key;
+		Value value;
+	};
+
+	static std::uint64_t MakeKey(int v0, int v1)
+	{
+		std::uint32_t a = static_cast<std::uint32_t>(v0);
+		std::uint32_t b = static_cast<std::uint32_t>(v1);
+		if(a > b)
+			std::swap(a, b);
+		return (std::uint64_t{a} << 32) | b;
+	}
+
+	// neighbouring vertex pairs scatter
+	static size_t Hash(std::uint64_t key) { return static_cast<size_t>(HashMix(key)); }
+
+	void Grow()
+	{
+		std::vector<Slot> oldSlots;
+		oldSlots.swap(slots);
+
+		slots.assign(oldSlots.empty() ? 16 : oldSlots.size() * 2, Slot{EMPTY_KEY, Value()});
+		mask = slots.size() - 1;
+
+		for(auto &s : oldSlots)
+		{
+			if(s.key == EMPTY_KEY)
+				continue;
+
+			size_t i = Hash(s.key) & mask;
+			while(slots[i].key != EMPTY_KEY)
+				i = (i + 1) & mask;
+			slots[i] = s;
+		}
+	}
+
+	std::vector<Slot> slots;
+	size_t numEntries;
+	size_t mask;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
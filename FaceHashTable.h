@@ -0,0 +1,115 @@
+#ifndef NV_FACE_HASH_TABLE_H
+#define NV_FACE_HASH_TABLE_H
+
+#include "HashMix.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Open addressing hash set of faces, keyed on their three vertex indices in order, so
+// (v0, v1, v2) and (v1, v2, v0) are different faces, like AlreadyExists() has
+// always had it.
+// Linear probing into a power of two sized table which is kept at most half full.
+// Degenerate faces never go in, which frees up (0, 0, 0) to mark the empty slots.
+class FaceHashTable
+{
+public:
+	FaceHashTable() : numEntries(0), mask(0) {}
+
+	// Sizes the table for about numFaces entries, throwing away anything it holds
+	void Reset(size_t numFaces)
+	{
+		size_t capacity = 16;
+		while(capacity < numFaces * 2)
+			capacity *= 2;
+
+		slots.assign(capacity, Slot{0, 0, 0});
+		numEntries = 0;
+		mask = capacity - 1;
+	}
+
+	// Adds the face unless it is already in the table, returns false if it was
+	bool Insert(int v0, int v1, int v2)
+	{
+		if((numEntries + 1) * 2 > slots.size())
+			Grow();
+
+		for(size_t i = Hash(v0, v1, v2) & mask; ; i = (i + 1) & mask)
+		{
+			Slot &s = slots[i];
+			if( (s.v0 == v0) && (s.v1 == v1) && (s.v2 == v2) )
+				return false;
+
+			if(IsEmpty(s))
+			{
+				s = Slot{v0, v1, v2};
+				++numEntries;
+				return true;
+			}
+		}
+	}
+
+	bool Contains(int v0, int v1, int v2) const
+	{
+		if(numEntries == 0)
+			return false;
+
+		for(size_t i = Hash(v0, v1, v2) & mask; ; i = (i + 1) & mask)
+		{
+			const Slot &s = slots[i];
+			if( (s.v0 == v0) && (s.v1 == v1) && (s.v2 == v2) )
+				return true;
+
+			if(IsEmpty(s))
+				return false;
+		}
+	}
+
+	size_t Size() const { return numEntries; }
+
+private:
+	struct Slot
+	{
+		int v0, v1, v2;
+	};
+
+	static bool IsEmpty(const Slot &s) { return (s.v0 == s.v1) && (s.v1 == s.v2); }
+
+	// mixed twice, so neighbouring faces scatter
+	static size_t Hash(int v0, int v1, int v2)
+	{
+		std::uint64_t key01 = (std::uint64_t{static_cast<std::uint32_t>(v0)} << 32) | static_cast<std::uint32_t>(v1);
+		return static_cast<size_t>(HashMix(HashMix(key01) ^ static_cast<std::uint32_t>(v2)));
+	}
+
+	void Grow()
+	{
+		std::vector<Slot> oldSlots;
+		oldSlots.swap(slots);
+
+		slots.assign(oldSlots.empty() ? 16 : oldSlots.size() * 2, Slot{0, 0, 0});
+		mask = slots.size() - 1;
+
+		for(auto &s : oldSlots)
+		{
+			if(IsEmpty(s))
+				continue;
+
+			size_t i = Hash(s.v0, s.v1, s.v2) & mask;
+			while(!IsEmpty(slots[i]))
+				i = (i + 1) & mask;
+			slots[i] = s;
+		}
+	}
+
+	std::vector<Slot> slots;
+	size_t numEntries;
+	size_t mask;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
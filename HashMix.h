@@ -0,0 +1,22 @@
+#ifndef NV_HASH_MIX_H
+#define NV_HASH_MIX_H
+
+#include <cstdint>
+
+namespace nv::tristrip::internal {
+
+// 64 bit finalizer from MurmurHash3, every bit of key ends up in every bit of the
+// result, so keys which differ a little, like neighbouring vertices, scatter
+inline std::uint64_t HashMix(std::uint64_t key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return key;
+}
+
+}  // namespace nv::tristrip::internal
+
+#endif
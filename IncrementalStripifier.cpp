@@ -0,0 +1,446 @@
+#include "IncrementalStripifier.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <limits>
+
+namespace nv::tristrip::internal {
+
+namespace {
+
+//seconds gone by since start, for the edit time
+double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Reset()
+//
+// Starts again with an empty mesh, stripified with options from now on
+//
+void NvIncrementalStripifier::Reset(const StripifyOptions& options)
+{
+	stripifier = std::make_unique<NvStripifier>();
+	stripifier->SetCachePolicy(options.bLRUCache ? CachePolicy::LRU : CachePolicy::FIFO);
+	stripifier->SetRestartStrips(options.bRestartStrips);
+	stripifier->SetCosts(StripCostsFor(options));
+	stripifier->SetEffort(static_cast<int>(std::min<unsigned int>(options.numSamples, std::numeric_limits<int>::max())),
+						  options.workBudget, options.bStopAtFullCover);
+	stripifier->SetSizes(static_cast<int>(options.cacheSize), options.minStripSize);
+
+	meshInfo = &stripifier->meshInfo;
+	meshInfo->Reset(0, 0);
+
+	bStrips = !(options.bListsOnly && (options.listOptimizer == ListOptimizer::LO_TIPSIFY));
+
+	triangleIndices.clear();
+	triangleFaces.clear();
+	bRemovedTriangles.clear();
+	numTriangles = 0;
+	maxIndex = 0;
+
+	faceRefs.clear();
+	unlinkedFaces.clear();
+
+	strips.clear();
+	listFaces.clear();
+	stripsById.clear();
+	freeIds.clear();
+
+	changedFaces.clear();
+	editTime = 0.0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// AddTriangles()
+//
+// Adds the triangles of an index list to the mesh, new faces are stripified by the next
+//  Update(), along with the strips next to them
+//
+size_t NvIncrementalStripifier::AddTriangles(const uint32_t* indices, size_t numIndices)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	size_t firstTriangle = triangleFaces.size();
+	size_t numNew = numIndices / 3;
+
+	triangleIndices.insert(triangleIndices.end(), indices, indices + numNew * 3);
+	triangleFaces.resize(firstTriangle + numNew, NV_INVALID_INDEX);
+	bRemovedTriangles.resize(firstTriangle + numNew, false);
+	numTriangles += numNew;
+
+	for(size_t i = 0; i < numNew * 3; i++)
+		maxIndex = std::max<size_t>(maxIndex, indices[i]);
+
+	if(bStrips && (numNew != 0))
+	{
+		//the first triangles make the mesh, sized for them, like a Stripify() would
+		if(meshInfo->NumFaces() == 0)
+			meshInfo->Reset(maxIndex + 1, numNew);
+		else
+		{
+			meshInfo->GrowVertices(maxIndex + 1);
+			ReserveFaces(meshInfo->NumFaces() + numNew);
+		}
+
+		for(size_t i = 0; i < numNew; i++)
+		{
+			unsigned int v0 = indices[i * 3 + 0];
+			unsigned int v1 = indices[i * 3 + 1];
+			unsigned int v2 = indices[i * 3 + 2];
+
+			//we disregard degenerates
+			if(stripifier->IsDegenerate(v0, v1, v2))
+				continue;
+
+			AddFace(firstTriangle + i, static_cast<int>(v0), static_cast<int>(v1), static_cast<int>(v2));
+		}
+	}
+
+	editTime += SecondsSince(start);
+	return firstTriangle;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// RemoveTriangles()
+//
+// Takes triangles out of the mesh, the strips they were in are stripified again by the
+//  next Update()
+//
+bool NvIncrementalStripifier::RemoveTriangles(const size_t* triangles, size_t numRemoved)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	for(size_t i = 0; i < numRemoved; i++)
+	{
+		size_t t = triangles[i];
+		if( (t >= triangleFaces.size()) || bRemovedTriangles[t] )
+		{
+			//take back the ones before, which are fine
+			for(size_t j = 0; j < i; j++)
+				bRemovedTriangles[triangles[j]] = false;
+			return false;
+		}
+
+		bRemovedTriangles[t] = true;
+	}
+
+	numTriangles -= numRemoved;
+
+	if(bStrips)
+	{
+		for(size_t i = 0; i < numRemoved; i++)
+		{
+			NvIndex face = triangleFaces[triangles[i]];
+			if( (face != NV_INVALID_INDEX) && (--faceRefs[face] == 0) )
+				RemoveFace(face);
+		}
+	}
+
+	editTime += SecondsSince(start);
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Throws away the strips and list faces the edits took apart, builds strips out of their
+//  faces and the new ones, and puts these where the first of the old ones were
+//
+void NvIncrementalStripifier::Update(ThreadPool* threadPool)
+{
+#ifdef NV_NVTS_ENABLE_PROFILING
+	stripifier->profile = StripifyProfile();
+#endif
+	NV_NVTS_PROFILE_THREAD(threadProfile, stripifier->profile);
+
+	stripifier->phaseTimes = NvPhaseTimes();
+	stripifier->phaseTimes.buildStripifyInfo = editTime;
+	editTime = 0.0;
+
+	size_t stripWindow = strips.size();
+	size_t numKept = 0;
+	for(auto *strip : strips)
+	{
+		if(strip->m_stripId >= 0)
+		{
+			strips[numKept++] = strip;
+			continue;
+		}
+
+		stripWindow = std::min(stripWindow, numKept);
+		stripifier->stripPool.Delete(strip);
+	}
+	strips.resize(numKept);
+	stripWindow = std::min(stripWindow, numKept);
+
+	size_t listWindow = listFaces.size();
+	numKept = 0;
+	for(auto *f : listFaces)
+	{
+		if(meshInfo->StripId(f) == LIST_STRIP_ID)
+			listFaces[numKept++] = f;
+		else
+			listWindow = std::min(listWindow, numKept);
+	}
+	listFaces.resize(numKept);
+	listWindow = std::min(listWindow, numKept);
+
+	//the faces which are in neither now, every other face is taken, so the strips stay among these
+	std::vector<NvIndex> faces;
+	for(auto f : changedFaces)
+	{
+		if(meshInfo->StripId(f) < 0)
+			faces.emplace_back(f);
+	}
+	changedFaces.clear();
+
+	if(faces.empty())
+		return;
+
+	//the first time that's every face, and the strips may start anywhere, just like Stripify()
+	NvStripInfoVec newStrips;
+	NvFaceInfoVec newListFaces;
+	stripifier->SetThreadPool(threadPool);
+	stripifier->SetResetFaces(faces.size() < meshInfo->NumFaces() ? &faces : nullptr);
+	stripifier->StripifyFreeFaces(newStrips, newListFaces);
+	stripifier->SetResetFaces(nullptr);
+	stripifier->SetThreadPool(nullptr);
+
+	//mark the faces with the strips they went to, so the next edit finds them
+	for(auto *strip : newStrips)
+	{
+		int id;
+		if(!freeIds.empty())
+		{
+			id = freeIds.back();
+			freeIds.pop_back();
+		}
+		else
+		{
+			id = static_cast<int>(stripsById.size());
+			stripsById.emplace_back(nullptr);
+		}
+
+		stripsById[id] = strip;
+		strip->m_stripId = id;
+		for(auto *f : strip->m_faces)
+		{
+			if(f->m_index != NV_INVALID_INDEX)
+				meshInfo->StripId(f) = id;
+		}
+	}
+
+	for(auto *f : newListFaces)
+		meshInfo->StripId(f) = LIST_STRIP_ID;
+
+	strips.insert(strips.begin() + stripWindow, newStrips.begin(), newStrips.end());
+	listFaces.insert(listFaces.begin() + listWindow, newListFaces.begin(), newListFaces.end());
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// GetTriangles()
+//
+// The indices of the triangles which haven't been removed
+//
+void NvIncrementalStripifier::GetTriangles(std::vector<uint32_t>& indices) const
+{
+	indices.clear();
+	indices.reserve(numTriangles * 3);
+
+	for(size_t t = 0; t < triangleFaces.size(); t++)
+	{
+		if(!bRemovedTriangles[t])
+			indices.insert(indices.end(), triangleIndices.begin() + t * 3, triangleIndices.begin() + t * 3 + 3);
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// FindFace()
+//
+// The face with exactly these vertices, in this order, NV_INVALID_INDEX if there is none.
+//  It is on at least one of the edges between them, unless it is one of the unlinked faces
+//
+NvIndex NvIncrementalStripifier::FindFace(int v0, int v1, int v2)
+{
+	auto isFace = [this, v0, v1, v2](NvIndex face) {
+		const NvFaceInfo *f = meshInfo->Face(face);
+		return (f != nullptr) && (f->m_v0 == v0) && (f->m_v1 == v1) && (f->m_v2 == v2);
+	};
+
+	int vertices[3] = {v0, v1, v2};
+	for(int i = 0; i < 3; i++)
+	{
+		const NvEdgeInfo *edgeInfo = meshInfo->FindEdge(vertices[i], vertices[(i + 1) % 3]);
+		if(edgeInfo == nullptr)
+			continue;
+
+		if(isFace(edgeInfo->m_face0))
+			return edgeInfo->m_face0;
+		if(isFace(edgeInfo->m_face1))
+			return edgeInfo->m_face1;
+	}
+
+	for(auto face : unlinkedFaces)
+	{
+		if(isFace(face))
+			return face;
+	}
+
+	return NV_INVALID_INDEX;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// AddFace()
+//
+// Makes triangle another copy of the face with these vertices, first adding it to the
+//  mesh if it isn't there yet.  The strips on the other side of its edges are taken apart,
+//  so the new face can join them
+//
+void NvIncrementalStripifier::AddFace(size_t triangle, int v0, int v1, int v2)
+{
+	NvIndex face = FindFace(v0, v1, v2);
+	if(face != NV_INVALID_INDEX)
+	{
+		++faceRefs[face];
+		triangleFaces[triangle] = face;
+		return;
+	}
+
+	//there's room for it, the strips don't need to follow the faces
+	assert(meshInfo->NumFaces() < meshInfo->FaceCapacity());
+	face = meshInfo->AddFace(v0, v1, v2);
+	faceRefs.emplace_back(1);
+	triangleFaces[triangle] = face;
+	changedFaces.emplace_back(face);
+
+	if(!meshInfo->LinkFace(face))
+		unlinkedFaces.emplace_back(face);
+
+	int vertices[3] = {v0, v1, v2};
+	for(int i = 0; i < 3; i++)
+	{
+		const NvEdgeInfo *edgeInfo = meshInfo->FindEdge(vertices[i], vertices[(i + 1) % 3]);
+		for(auto f : {edgeInfo->m_face0, edgeInfo->m_face1})
+		{
+			if( (f != NV_INVALID_INDEX) && (f != face) )
+				ReleaseFace(f);
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// RemoveFace()
+//
+// Takes a face out of the mesh, once no triangle is it any more
+//
+void NvIncrementalStripifier::RemoveFace(NvIndex face)
+{
+	ReleaseFace(face);
+
+	meshInfo->StripId(meshInfo->Face(face)) = REMOVED_STRIP_ID;
+	meshInfo->UnlinkFace(face);
+
+	auto unlinked = std::find(unlinkedFaces.begin(), unlinkedFaces.end(), face);
+	if(unlinked != unlinkedFaces.end())
+		unlinkedFaces.erase(unlinked);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ReleaseFace()
+//
+// Takes a face out of the list, or takes apart the whole strip it is in, so the next
+//  Update() stripifies it again
+//
+void NvIncrementalStripifier::ReleaseFace(NvIndex face)
+{
+	int &stripId = meshInfo->StripId(meshInfo->Face(face));
+	if(stripId == LIST_STRIP_ID)
+	{
+		//Update() drops it from the list
+		stripId = -1;
+		changedFaces.emplace_back(face);
+		return;
+	}
+
+	//not in anything yet, or gone
+	if( (stripId < 0) || (stripId == REMOVED_STRIP_ID) )
+		return;
+
+	NvStripInfo *strip = stripsById[stripId];
+	stripsById[stripId] = nullptr;
+	freeIds.emplace_back(stripId);
+
+	//Update() drops it from the strips
+	strip->m_stripId = -1;
+
+	for(auto *f : strip->m_faces)
+	{
+		if(f->m_index == NV_INVALID_INDEX)
+			continue;
+
+		meshInfo->StripId(f) = -1;
+		changedFaces.emplace_back(f->m_index);
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ReserveFaces()
+//
+// Makes room for numFaces faces.  Moving the faces moves them out from under the strips
+//  and the list, so those are pointed at where the faces went
+//
+void NvIncrementalStripifier::ReserveFaces(size_t numFaces)
+{
+	if(numFaces <= meshInfo->FaceCapacity())
+		return;
+
+	//the degenerate faces of the strips don't belong to the mesh, and stay where they are
+	std::vector<NvIndex> faceIndices;
+	for(auto *strip : strips)
+	{
+		//the ones taken apart are never looked in again
+		if(strip->m_stripId < 0)
+			continue;
+
+		for(auto *f : strip->m_faces)
+			faceIndices.emplace_back(f->m_index);
+	}
+	for(auto *f : listFaces)
+		faceIndices.emplace_back(f->m_index);
+
+	//grow geometrically, so a run of small edits doesn't move them every time
+	meshInfo->ReserveFaces(std::max(numFaces, meshInfo->FaceCapacity() * 2));
+
+	size_t i = 0;
+	for(auto *strip : strips)
+	{
+		if(strip->m_stripId < 0)
+			continue;
+
+		for(auto &f : strip->m_faces)
+		{
+			NvIndex face = faceIndices[i++];
+			if(face != NV_INVALID_INDEX)
+				f = meshInfo->Face(face);
+		}
+	}
+	for(auto &f : listFaces)
+		f = meshInfo->Face(faceIndices[i++]);
+}
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,113 @@
+#ifndef NV_INCREMENTAL_STRIPIFIER_H
+#define NV_INCREMENTAL_STRIPIFIER_H
+
+#include "NvTriStrip.h"
+#include "NvTriStripObjects.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Keeps a mesh and its strips from one edit to the next, so only the strips around the
+// triangles which changed are built again.
+//
+// Triangles are numbered in the order they are added, and keep their number until they
+// are removed.  Copies of a face share it, and it only goes once the last of them does.
+// Removed faces stay in the mesh, taken off their edges and marked as in a strip which
+// doesn't exist, so the indices of all the other faces and edges stay put.
+//
+// Every strip handed out has an id, and its faces are marked with it instead of the id
+// of the strip it was cut from, the faces of the list with LIST_STRIP_ID.  So an edit
+// finds the strips it touches right away: those holding a removed face, or a face on an
+// edge of a new one.  They are thrown away, and Update() stripifies their faces and the
+// new ones, starting strips only on those, while every other face is taken.  The new
+// strips go where the first of the old ones was, and the new list faces where the first
+// of the old ones was, so the cache order of the rest of the mesh stays as it was.
+class NvIncrementalStripifier
+{
+public:
+	// faces of the list, and removed faces, are marked as being in these strips
+	static constexpr int LIST_STRIP_ID{std::numeric_limits<int>::max() - 1};
+	static constexpr int REMOVED_STRIP_ID{std::numeric_limits<int>::max()};
+
+	NvIncrementalStripifier() { Reset(StripifyOptions()); }
+
+	NvIncrementalStripifier(const NvIncrementalStripifier&) = delete;
+	NvIncrementalStripifier& operator=(const NvIncrementalStripifier&) = delete;
+
+	// throws away the mesh, to start again with these options.  With LO_TIPSIFY lists
+	//  there are no strips, and only the triangles are kept
+	void Reset(const StripifyOptions& options);
+
+	// adds triangles, numbered on from the last one added, returns the number of the first
+	size_t AddTriangles(const uint32_t* indices, size_t numIndices);
+
+	// returns false, removing nothing, if any of them isn't in the mesh
+	bool RemoveTriangles(const size_t* triangles, size_t numTriangles);
+
+	// faces which Update() will stripify
+	size_t NumChangedFaces() const { return changedFaces.size(); }
+
+	// stripifies the faces which changed since the last time, on threadPool if it isn't nullptr
+	void Update(ThreadPool* threadPool);
+
+	// all the strips, in order, and the faces of the list after them, as of the last Update()
+	const NvStripInfoVec& Strips() const { return strips; }
+	const NvFaceInfoVec& ListFaces() const { return listFaces; }
+
+	// triangles in the mesh now, and their indices, in the order they were added
+	size_t NumTriangles() const { return numTriangles; }
+	void GetTriangles(std::vector<uint32_t>& indices) const;
+
+	// biggest vertex index ever added
+	size_t MaxIndex() const { return maxIndex; }
+
+	NvStripifier& Stripifier() { return *stripifier; }
+
+	// how long the edits since the last Update() took, in seconds
+	double EditTime() const { return editTime; }
+
+private:
+	NvIndex FindFace(int v0, int v1, int v2);
+	void AddFace(size_t triangle, int v0, int v1, int v2);
+	void RemoveFace(NvIndex face);
+	void ReleaseFace(NvIndex face);
+	void ReserveFaces(size_t numFaces);
+
+	// owns the mesh, and all the strips, a new one for every mesh
+	std::unique_ptr<NvStripifier> stripifier;
+	NvMeshInfo* meshInfo = nullptr;
+
+	bool bStrips = true;
+
+	// per triangle, its 3 indices, and its face, NV_INVALID_INDEX if it is degenerate
+	std::vector<uint32_t> triangleIndices;
+	std::vector<NvIndex>  triangleFaces;
+	std::vector<bool>     bRemovedTriangles;
+	size_t numTriangles = 0;
+	size_t maxIndex = 0;
+
+	// per face, how many triangles are it, 0 once it is removed
+	std::vector<uint32_t> faceRefs;
+
+	// faces which aren't on any of their edges, the only ones FindFace() can't find there
+	std::vector<NvIndex> unlinkedFaces;
+
+	// the strips in order, and the list, and each strip by its id, nullptr for free ids
+	NvStripInfoVec strips;
+	NvFaceInfoVec  listFaces;
+	NvStripInfoVec stripsById;
+	std::vector<int> freeIds;
+
+	// faces taken out of their strip or the list, or added, since the last Update()
+	std::vector<NvIndex> changedFaces;
+	double editTime = 0.0;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
@@ -0,0 +1,181 @@
+#include "ListOptimizer.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace nv::tristrip::internal {
+
+namespace {
+
+// The mesh as Tipsify wants it: for each vertex the triangles using it, and how many
+// of those haven't been emitted yet
+template<typename IndexT>
+class ListOptimizerState
+{
+public:
+	ListOptimizerState(const IndexT* in_indices, size_t numIndices, size_t numVertices, size_t in_cacheSize,
+					   CachePolicy in_policy) :
+		indices(in_indices), cacheSize(in_cacheSize), policy(in_policy)
+	{
+		//keep the triangles which aren't degenerate
+		size_t numTriangles = numIndices / 3;
+		triangles.reserve(numTriangles);
+		for(size_t t = 0; t < numTriangles; t++)
+		{
+			unsigned int v0 = indices[t * 3 + 0];
+			unsigned int v1 = indices[t * 3 + 1];
+			unsigned int v2 = indices[t * 3 + 2];
+			if( (v0 != v1) && (v0 != v2) && (v1 != v2) )
+				triangles.emplace_back(t);
+		}
+
+		//vertex -> triangles, by counting sort
+		numLive.assign(numVertices, 0);
+		for(auto t : triangles)
+		{
+			for(size_t c = 0; c < 3; c++)
+				++numLive[indices[t * 3 + c]];
+		}
+
+		adjacencyStarts.assign(numVertices + 1, 0);
+		for(size_t v = 0; v < numVertices; v++)
+			adjacencyStarts[v + 1] = adjacencyStarts[v] + numLive[v];
+
+		adjacency.resize(adjacencyStarts[numVertices]);
+		std::vector<size_t> fill(adjacencyStarts.begin(), adjacencyStarts.end() - 1);
+		for(size_t i = 0; i < triangles.size(); i++)
+		{
+			for(size_t c = 0; c < 3; c++)
+				adjacency[fill[indices[triangles[i] * 3 + c]]++] = i;
+		}
+
+		bEmitted.assign(triangles.size(), false);
+
+		//every vertex starts out long gone from the cache
+		timeStamps.assign(numVertices, 0);
+		time = cacheSize + 1;
+	}
+
+	void Run(std::vector<IndexT>& outIndices)
+	{
+		outIndices.clear();
+		outIndices.reserve(triangles.size() * 3);
+
+		size_t cursor = 0;
+		std::ptrdiff_t fanVertex = triangles.empty() ? -1 : 0;
+		std::vector<IndexT> candidates;
+
+		while(fanVertex >= 0)
+		{
+			//emit every triangle left around the fanning vertex
+			candidates.clear();
+			for(size_t i = adjacencyStarts[fanVertex]; i < adjacencyStarts[fanVertex + 1]; i++)
+			{
+				size_t t = adjacency[i];
+				if(bEmitted[t])
+					continue;
+
+				for(size_t c = 0; c < 3; c++)
+				{
+					unsigned int v = indices[triangles[t] * 3 + c];
+					outIndices.emplace_back(v);
+					deadEnds.emplace_back(v);
+					candidates.emplace_back(v);
+					--numLive[v];
+
+					if( !InCache(v) || (policy == CachePolicy::LRU) )
+						timeStamps[v] = time++;
+				}
+
+				bEmitted[t] = true;
+			}
+
+			fanVertex = NextVertex(candidates, cursor);
+		}
+	}
+
+private:
+	bool InCache(unsigned int v) const { return (time - timeStamps[v]) <= cacheSize; }
+
+	// The candidate which will still be in the cache after its remaining triangles are
+	// emitted, and has been there longest, or a dead end fallback if there is none
+	std::ptrdiff_t NextVertex(const std::vector<IndexT>& candidates, size_t& cursor)
+	{
+		std::ptrdiff_t best = -1;
+		size_t bestPriority = 0;
+		for(auto v : candidates)
+		{
+			if(numLive[v] == 0)
+				continue;
+
+			//priority 0 unless fanning around v keeps it in the cache till the end,
+			// each triangle adds at most two new vertices
+			size_t priority = 0;
+			if(time - timeStamps[v] + 2 * numLive[v] <= cacheSize)
+				priority = time - timeStamps[v];
+
+			if( (best == -1) || (priority > bestPriority) )
+			{
+				best = v;
+				bestPriority = priority;
+			}
+		}
+
+		if(best == -1)
+			best = SkipDeadEnd(cursor);
+
+		return best;
+	}
+
+	// Goes back through the vertices we used most recently for one with triangles left,
+	// then on through the vertices in order
+	std::ptrdiff_t SkipDeadEnd(size_t& cursor)
+	{
+		while(!deadEnds.empty())
+		{
+			unsigned int v = deadEnds.back();
+			deadEnds.pop_back();
+			if(numLive[v] > 0)
+				return v;
+		}
+
+		for(; cursor < numLive.size(); cursor++)
+		{
+			if(numLive[cursor] > 0)
+				return static_cast<std::ptrdiff_t>(cursor);
+		}
+
+		return -1;
+	}
+
+	const IndexT* indices;
+	size_t cacheSize;
+	CachePolicy policy;
+
+	std::vector<size_t> triangles;  // the input triangles we keep, the rest refer to them by position here
+	std::vector<size_t> adjacency;
+	std::vector<size_t> adjacencyStarts;
+	std::vector<size_t> numLive;
+	std::vector<bool>   bEmitted;
+
+	std::vector<size_t> timeStamps;
+	size_t time;
+
+	std::vector<IndexT> deadEnds;
+};
+
+}  // namespace
+
+
+template<typename IndexT>
+void OptimizeListForCache(const IndexT* indices, size_t numIndices, size_t numVertices,
+						  size_t cacheSize, CachePolicy policy, std::vector<IndexT>& outIndices)
+{
+	ListOptimizerState<IndexT> state(indices, numIndices, numVertices, std::max<size_t>(cacheSize, 1), policy);
+	state.Run(outIndices);
+}
+
+template void OptimizeListForCache<uint16_t>(const uint16_t*, size_t, size_t, size_t, CachePolicy, std::vector<uint16_t>&);
+template void OptimizeListForCache<uint32_t>(const uint32_t*, size_t, size_t, size_t, CachePolicy, std::vector<uint32_t>&);
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,31 @@
+#ifndef NV_LIST_OPTIMIZER_H
+#define NV_LIST_OPTIMIZER_H
+
+#include "VertexCache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Reorders the triangles of an indexed list for the vertex cache, in time linear in the
+// size of the mesh, following Tipsify (Sander, Nehab and Barczak, "Fast Triangle
+// Reordering for Vertex Locality and Reduced Overdraw", 2007).
+//
+// We fan around one vertex at a time, emitting all its triangles, then move on to the
+// vertex of those triangles which stays in the cache longest while still having
+// triangles left, falling back to recently used vertices, and finally to the next
+// vertex in index order, when we hit a dead end.
+//
+// The cache is assumed to hold cacheSize vertices.  With CachePolicy::FIFO only misses
+// push them along, like real hardware does; with LRU every use refreshes a vertex.
+// Degenerate triangles are dropped, everything else keeps its winding.
+// IndexT is uint16_t or uint32_t.
+template<typename IndexT>
+void OptimizeListForCache(const IndexT* indices, size_t numIndices, size_t numVertices,
+						  size_t cacheSize, CachePolicy policy, std::vector<IndexT>& outIndices);
+
+}  // namespace nv::tristrip::internal
+
+#endif
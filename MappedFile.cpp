@@ -0,0 +1,116 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <limits>
+
+namespace nv::tristrip::internal {
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Open()
+//
+// Maps the whole of fileName.  The mapping stays valid after the file itself is closed
+//
+bool MappedFile::Open(const char* fileName)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx(file, &fileSize) ||
+		(static_cast<std::uint64_t>(fileSize.QuadPart) > std::numeric_limits<size_t>::max()) )
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	//mapping nothing fails, and there is nothing to map anyway
+	if(fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if(mapping == nullptr)
+		return false;
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if(view == nullptr)
+		return false;
+
+	data = static_cast<const unsigned char*>(view);
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int file = open(fileName, O_RDONLY);
+	if(file < 0)
+		return false;
+
+	struct stat fileStat;
+	if( (fstat(file, &fileStat) != 0) || !S_ISREG(fileStat.st_mode) ||
+		(static_cast<std::uint64_t>(fileStat.st_size) > std::numeric_limits<size_t>::max()) )
+	{
+		close(file);
+		return false;
+	}
+
+	//mapping nothing fails, and there is nothing to map anyway
+	if(fileStat.st_size == 0)
+	{
+		close(file);
+		return true;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if(view == MAP_FAILED)
+		return false;
+
+	data = static_cast<const unsigned char*>(view);
+	size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Close()
+//
+void MappedFile::Close()
+{
+	if(data != nullptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+#else
+		munmap(const_cast<unsigned char*>(data), size);
+#endif
+	}
+
+	data = nullptr;
+	size = 0;
+}
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,35 @@
+#ifndef NV_MAPPED_FILE_H
+#define NV_MAPPED_FILE_H
+
+#include <cstddef>
+
+namespace nv::tristrip::internal {
+
+// A whole file mapped read only into memory, so its contents can be used right where
+// they are instead of being read into a buffer first.  The pages come in from disk as
+// they are touched, and go back to the system when the file is closed.
+// An empty file opens fine, with no data.
+class MappedFile
+{
+public:
+	MappedFile() : data(nullptr), size(0) {}
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Maps fileName, closing whatever was mapped before, returns false if it can't
+	bool Open(const char* fileName);
+	void Close();
+
+	const unsigned char* Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	const unsigned char* data;
+	size_t size;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
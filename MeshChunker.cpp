@@ -0,0 +1,190 @@
+#include "MeshChunker.h"
+#include "FaceHashTable.h"
+#include "NvTriStripObjects.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace nv::tristrip::internal {
+
+namespace {
+
+// Spreads the low 10 bits of x out to every third bit
+std::uint64_t SpreadBits(std::uint64_t x)
+{
+	x &= 0x3ff;
+	x = (x | (x << 16)) & 0x30000ff;
+	x = (x | (x << 8))  & 0x300f00f;
+	x = (x | (x << 4))  & 0x30c30c3;
+	x = (x | (x << 2))  & 0x9249249;
+	return x;
+}
+
+//the triangle numbers go under the 30 bits of the cell in the sort keys
+constexpr unsigned int TRIANGLE_BITS = 34;
+
+//hash table slot of CompactChunk() which holds no vertex
+constexpr uint32_t EMPTY_SLOT = ~uint32_t{0};
+
+}  // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// CompactChunk()
+//
+// Numbers the vertices a run of triangles uses from 0, in the order they are first used
+//
+template<typename IndexT>
+void CompactChunk(const IndexT* indices, size_t numIndices,
+				  std::vector<uint32_t>& localIndices, std::vector<uint32_t>& vertices)
+{
+	//open addressing from original to local index, at most half full even if every index
+	// is a different vertex.  the slots hold the local index, keyed on vertices[]
+	size_t capacity = 16;
+	while(capacity < numIndices * 2)
+		capacity *= 2;
+
+	const size_t mask = capacity - 1;
+	std::vector<uint32_t> slots(capacity, EMPTY_SLOT);
+
+	vertices.clear();
+	localIndices.resize(numIndices);
+	for(size_t i = 0; i < numIndices; i++)
+	{
+		const uint32_t v = indices[i];
+
+		size_t s = static_cast<size_t>(v * 0x9e3779b97f4a7c15ULL >> 32) & mask;
+		while( (slots[s] != EMPTY_SLOT) && (vertices[slots[s]] != v) )
+			s = (s + 1) & mask;
+
+		if(slots[s] == EMPTY_SLOT)
+		{
+			slots[s] = static_cast<uint32_t>(vertices.size());
+			vertices.emplace_back(v);
+		}
+
+		localIndices[i] = slots[s];
+	}
+
+	vertices.shrink_to_fit();
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// RemoveDuplicateFaces()
+//
+// One pass through the whole list, so copies in different chunks are found too.  The
+//  indices are only copied once there is a copy to leave out
+//
+template<typename IndexT>
+bool RemoveDuplicateFaces(const IndexT* indices, size_t numIndices, std::vector<IndexT>& uniqueIndices)
+{
+	const size_t numTriangles = numIndices / 3;
+
+	FaceHashTable faces;
+	faces.Reset(numTriangles);
+
+	uniqueIndices.clear();
+	bool bDuplicates = false;
+	for(size_t t = 0; t < numTriangles; t++)
+	{
+		const IndexT* face = indices + t * 3;
+		const int v0 = static_cast<int>(face[0]);
+		const int v1 = static_cast<int>(face[1]);
+		const int v2 = static_cast<int>(face[2]);
+
+		//degenerate faces never go in the table, the stripifier drops them anyway
+		const bool bDegenerate = (v0 == v1) || (v1 == v2) || (v0 == v2);
+		if(bDegenerate || faces.Insert(v0, v1, v2))
+		{
+			if(bDuplicates)
+				uniqueIndices.insert(uniqueIndices.end(), face, face + 3);
+			continue;
+		}
+
+		//the first copy, everything before it goes in as it is
+		if(!bDuplicates)
+		{
+			bDuplicates = true;
+			uniqueIndices.reserve(numTriangles * 3);
+			uniqueIndices.assign(indices, face);
+		}
+	}
+
+	return bDuplicates;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// SortTrianglesSpatially()
+//
+// Sorts the triangles on the Morton code of the cell their middle is in, see the header
+//
+template<typename IndexT>
+void SortTrianglesSpatially(IndexT* indices, size_t numIndices, const float* positions, size_t positionStride)
+{
+	const size_t numTriangles = numIndices / 3;
+	if(numTriangles < 2)
+		return;
+
+	assert(numTriangles < (std::uint64_t{1} << TRIANGLE_BITS));
+
+	//middles are left a factor of 3 bigger, it makes no difference to where they go
+	auto middle = [indices, positions, positionStride](size_t t, int c) {
+		return VertexPosition(positions, positionStride, indices[t * 3 + 0])[c] +
+			   VertexPosition(positions, positionStride, indices[t * 3 + 1])[c] +
+			   VertexPosition(positions, positionStride, indices[t * 3 + 2])[c];
+	};
+
+	float boxMin[3] = { std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max()};
+	float boxMax[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+	for(size_t t = 0; t < numTriangles; t++)
+	{
+		for(int c = 0; c < 3; c++)
+		{
+			float m = middle(t, c);
+			boxMin[c] = std::min(boxMin[c], m);
+			boxMax[c] = std::max(boxMax[c], m);
+		}
+	}
+
+	//a flat box gets every middle into its one layer of cells
+	float scale[3];
+	for(int c = 0; c < 3; c++)
+		scale[c] = (boxMax[c] > boxMin[c]) ? 1023.0f / (boxMax[c] - boxMin[c]) : 0.0f;
+
+	//the triangle number makes the keys unique, which keeps the sort stable
+	std::vector<std::uint64_t> keys(numTriangles);
+	for(size_t t = 0; t < numTriangles; t++)
+	{
+		std::uint64_t code = 0;
+		for(int c = 0; c < 3; c++)
+		{
+			auto cell = static_cast<std::uint64_t>((middle(t, c) - boxMin[c]) * scale[c] + 0.5f);
+			code |= SpreadBits(std::min<std::uint64_t>(cell, 1023)) << c;
+		}
+
+		keys[t] = (code << TRIANGLE_BITS) | t;
+	}
+	std::sort(std::begin(keys), std::end(keys));
+
+	std::vector<IndexT> sorted(numTriangles * 3);
+	for(size_t t = 0; t < numTriangles; t++)
+	{
+		size_t from = static_cast<size_t>(keys[t] & ((std::uint64_t{1} << TRIANGLE_BITS) - 1));
+		std::copy(indices + from * 3, indices + from * 3 + 3, sorted.data() + t * 3);
+	}
+
+	std::copy(std::begin(sorted), std::end(sorted), indices);
+}
+
+//the index widths we chunk up
+template bool RemoveDuplicateFaces<uint16_t>(const uint16_t*, size_t, std::vector<uint16_t>&);
+template bool RemoveDuplicateFaces<uint32_t>(const uint32_t*, size_t, std::vector<uint32_t>&);
+template void CompactChunk<uint16_t>(const uint16_t*, size_t, std::vector<uint32_t>&, std::vector<uint32_t>&);
+template void CompactChunk<uint32_t>(const uint32_t*, size_t, std::vector<uint32_t>&, std::vector<uint32_t>&);
+template void SortTrianglesSpatially<uint16_t>(uint16_t*, size_t, const float*, size_t);
+template void SortTrianglesSpatially<uint32_t>(uint32_t*, size_t, const float*, size_t);
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,35 @@
+#ifndef NV_MESH_CHUNKER_H
+#define NV_MESH_CHUNKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Gives a run of triangles out of a bigger mesh vertex numbers of its own, 0 up to the
+// number of different vertices it uses, so everything the stripifier keeps per vertex
+// is only as big as the run, however sparse its indices are.
+// vertices is filled in with the original index of each local vertex, numbered in the
+// order the run first uses them.
+template<typename IndexT>
+void CompactChunk(const IndexT* indices, size_t numIndices,
+				  std::vector<uint32_t>& localIndices, std::vector<uint32_t>& vertices);
+
+// Finds the triangles of an indexed list which are exact copies of one before them, the
+// same three indices in the same order, as the stripifier drops them.  Returns false if
+// there are none, leaving uniqueIndices empty, or fills it in with the list without them.
+template<typename IndexT>
+bool RemoveDuplicateFaces(const IndexT* indices, size_t numIndices, std::vector<IndexT>& uniqueIndices);
+
+// Reorders the triangles of an indexed list, in place, along a Morton curve through the
+// middles of the triangles, so each run of triangles in the new order sits in one compact
+// piece of space.  The curve runs over a 1024 cell grid on each side of the box around
+// the middles; triangles in the same cell keep the order they were in, and every
+// triangle keeps its winding.
+template<typename IndexT>
+void SortTrianglesSpatially(IndexT* indices, size_t numIndices, const float* positions, size_t positionStride);
+
+}  // namespace nv::tristrip::internal
+
+#endif
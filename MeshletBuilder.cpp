@@ -0,0 +1,261 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+
+namespace nv::tristrip::internal {
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// Build()
+//
+// Cuts the mesh in indices up into meshlets, see the class
+//
+template<typename IndexT>
+void NvMeshletBuilder::Build(const IndexT* indices, size_t numIndices, size_t maxIndex,
+							 const float* positions, size_t positionStride, MeshletResult& result)
+{
+	result.Clear();
+
+	stripifier.BuildStripifyInfo(stripifier.meshInfo, indices, numIndices, maxIndex);
+	meshInfo = &stripifier.meshInfo;
+
+	size_t numFaces = meshInfo->NumFaces();
+	vertexMeshlet.assign(meshInfo->NumVertices(), -1);
+	localIndex.assign(meshInfo->NumVertices(), 0);
+	frontier.clear();
+	frontierMeshlet.assign(numFaces, -1);
+	firstFreeFace = 0;
+
+	if(numFaces == 0)
+		return;
+
+	// start at an edge of the mesh, like the strips do
+	stripifier.bFirstTimeResetPoint = true;
+	stripifier.meshJump = 0.0f;
+	NvFaceInfo *firstFace = stripifier.FindGoodResetPoint(*meshInfo);
+	NvIndex seed = (firstFace != nullptr) ? firstFace->m_index : NextFreeFace();
+
+	while(seed != NV_INVALID_INDEX)
+	{
+		meshletId = static_cast<int>(result.meshlets.size());
+
+		Meshlet meshlet{};
+		meshlet.vertexOffset   = static_cast<uint32_t>(result.vertices.size());
+		meshlet.triangleOffset = static_cast<uint32_t>(result.triangles.size() / 3);
+
+		frontier.clear();
+		AddFace(seed, meshlet, result);
+
+		while(meshlet.triangleCount < maxTriangles)
+		{
+			// find the face around the meshlet adding the fewest new vertices which still fits,
+			//  dropping the ones other meshlets took on the way
+			size_t bestSlot = frontier.size();
+			size_t bestNew  = 4;
+			size_t numLeft  = 0;
+			for(auto f : frontier)
+			{
+				if(meshInfo->StripId(f) >= 0)
+					continue;
+
+				frontier[numLeft++] = f;
+
+				size_t numNew = NumNewVertices(meshInfo->Face(f));
+				if( (numNew < bestNew) && (meshlet.vertexCount + numNew <= maxVertices) )
+				{
+					bestNew  = numNew;
+					bestSlot = numLeft - 1;
+				}
+			}
+			frontier.resize(numLeft);
+
+			NvIndex next = NV_INVALID_INDEX;
+			if(bestSlot < frontier.size())
+				next = frontier[bestSlot];
+			else if(frontier.empty() && (meshlet.vertexCount + 3 <= maxVertices))
+				next = NextFreeFace();  // nothing left around us, top up from somewhere else
+
+			if(next == NV_INVALID_INDEX)
+				break;
+
+			AddFace(next, meshlet, result);
+		}
+
+		CalcBounds(meshlet, result, positions, positionStride);
+		result.meshlets.emplace_back(meshlet);
+
+		// carry on next to this meshlet if we can
+		seed = NV_INVALID_INDEX;
+		for(auto f : frontier)
+		{
+			if(meshInfo->StripId(f) < 0)
+			{
+				seed = f;
+				break;
+			}
+		}
+
+		if(seed == NV_INVALID_INDEX)
+			seed = NextFreeFace();
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// AddFace()
+//
+// Puts a face in the meshlet in the making, along with whichever of its vertices aren't
+//  yet, and adds the free faces around those vertices to the frontier
+//
+void NvMeshletBuilder::AddFace(NvIndex face, Meshlet& meshlet, MeshletResult& result)
+{
+	NvFaceInfo *faceInfo = meshInfo->Face(face);
+	meshInfo->StripId(faceInfo) = meshletId;
+
+	int vertices[3] = {faceInfo->m_v0, faceInfo->m_v1, faceInfo->m_v2};
+	for(auto v : vertices)
+	{
+		if(vertexMeshlet[v] != meshletId)
+		{
+			vertexMeshlet[v] = meshletId;
+			localIndex[v]    = static_cast<uint8_t>(meshlet.vertexCount++);
+			result.vertices.emplace_back(static_cast<uint32_t>(v));
+
+			for(NvEdgeInfo *edgeInfo = meshInfo->FirstEdge(v); edgeInfo != nullptr; edgeInfo = meshInfo->NextEdge(edgeInfo, v))
+			{
+				for(auto f : {edgeInfo->m_face0, edgeInfo->m_face1})
+				{
+					if( (f == NV_INVALID_INDEX) || (meshInfo->StripId(f) >= 0) || (frontierMeshlet[f] == meshletId) )
+						continue;
+
+					frontierMeshlet[f] = meshletId;
+					frontier.emplace_back(f);
+				}
+			}
+		}
+
+		result.triangles.emplace_back(localIndex[v]);
+	}
+
+	++meshlet.triangleCount;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// NumNewVertices()
+//
+// How many of the face's vertices aren't in the meshlet in the making yet
+//
+size_t NvMeshletBuilder::NumNewVertices(const NvFaceInfo* face) const
+{
+	return size_t(vertexMeshlet[face->m_v0] != meshletId) +
+		   size_t(vertexMeshlet[face->m_v1] != meshletId) +
+		   size_t(vertexMeshlet[face->m_v2] != meshletId);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// NextFreeFace()
+//
+// The first face no meshlet has taken, NV_INVALID_INDEX once they all have
+//
+NvIndex NvMeshletBuilder::NextFreeFace()
+{
+	size_t numFaces = meshInfo->NumFaces();
+	while( (firstFreeFace < numFaces) && (meshInfo->StripId(static_cast<NvIndex>(firstFreeFace)) >= 0) )
+		++firstFreeFace;
+
+	return (firstFreeFace < numFaces) ? static_cast<NvIndex>(firstFreeFace) : NV_INVALID_INDEX;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// CalcBounds()
+//
+// The bounding sphere and normal cone of a finished meshlet, left at 0 without positions
+//
+void NvMeshletBuilder::CalcBounds(Meshlet& meshlet, const MeshletResult& result,
+								  const float* positions, size_t positionStride) const
+{
+	if(positions == nullptr)
+		return;
+
+	const uint32_t* vertices = result.vertices.data() + meshlet.vertexOffset;
+	const uint8_t* triangles = result.triangles.data() + size_t{meshlet.triangleOffset} * 3;
+
+	//the sphere goes around the middle of the box around the vertices
+	float boxMin[3] = { std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max()};
+	float boxMax[3] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+	for(uint32_t i = 0; i < meshlet.vertexCount; i++)
+	{
+		const float* p = VertexPosition(positions, positionStride, vertices[i]);
+		for(int c = 0; c < 3; c++)
+		{
+			boxMin[c] = std::min(boxMin[c], p[c]);
+			boxMax[c] = std::max(boxMax[c], p[c]);
+		}
+	}
+
+	for(int c = 0; c < 3; c++)
+		meshlet.center[c] = (boxMin[c] + boxMax[c]) * 0.5f;
+
+	float radiusSquared = 0.0f;
+	for(uint32_t i = 0; i < meshlet.vertexCount; i++)
+	{
+		const float* p = VertexPosition(positions, positionStride, vertices[i]);
+		float dx = p[0] - meshlet.center[0], dy = p[1] - meshlet.center[1], dz = p[2] - meshlet.center[2];
+		radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+	}
+	meshlet.radius = std::sqrt(radiusSquared);
+
+	//the cone is around the average of the unit normals, and just wide enough to hold all of them
+	std::vector<float> normals;
+	normals.reserve(size_t{meshlet.triangleCount} * 3);
+	float axis[3] = {0.0f, 0.0f, 0.0f};
+	for(uint32_t t = 0; t < meshlet.triangleCount; t++)
+	{
+		const float* p0 = VertexPosition(positions, positionStride, vertices[triangles[t * 3 + 0]]);
+		const float* p1 = VertexPosition(positions, positionStride, vertices[triangles[t * 3 + 1]]);
+		const float* p2 = VertexPosition(positions, positionStride, vertices[triangles[t * 3 + 2]]);
+
+		float ex = p1[0] - p0[0], ey = p1[1] - p0[1], ez = p1[2] - p0[2];
+		float fx = p2[0] - p0[0], fy = p2[1] - p0[1], fz = p2[2] - p0[2];
+		float n[3] = {ey * fz - ez * fy, ez * fx - ex * fz, ex * fy - ey * fx};
+		float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+		//no area, no say in which way the meshlet faces
+		if(length <= 0.0f)
+			continue;
+
+		for(int c = 0; c < 3; c++)
+		{
+			normals.emplace_back(n[c] / length);
+			axis[c] += n[c] / length;
+		}
+	}
+
+	float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+	if(axisLength <= 0.0f)
+		return;
+
+	for(int c = 0; c < 3; c++)
+		meshlet.coneAxis[c] = axis[c] / axisLength;
+
+	float cutoff = 1.0f;
+	for(size_t i = 0; i < normals.size(); i += 3)
+	{
+		cutoff = std::min(cutoff, normals[i + 0] * meshlet.coneAxis[0] +
+								  normals[i + 1] * meshlet.coneAxis[1] +
+								  normals[i + 2] * meshlet.coneAxis[2]);
+	}
+	meshlet.coneCutoff = cutoff;
+}
+
+//the index widths we build meshlets from
+template void NvMeshletBuilder::Build<uint16_t>(const uint16_t*, size_t, size_t, const float*, size_t, MeshletResult&);
+template void NvMeshletBuilder::Build<uint32_t>(const uint32_t*, size_t, size_t, const float*, size_t, MeshletResult&);
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,61 @@
+#ifndef NV_MESHLET_BUILDER_H
+#define NV_MESHLET_BUILDER_H
+
+#include "NvTriStrip.h"
+#include "NvTriStripObjects.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Grows meshlets over the adjacency of an NvStripifier's mesh.
+//
+// The first meshlet starts on the face FindGoodResetPoint() would start strips on, at an
+// edge of the mesh.  A meshlet takes in, one at a time, the face around its vertices
+// which adds the fewest new vertices, the first one found on a tie, until the next one
+// won't fit.  The faces around it which are left over seed the next meshlet, so the
+// meshlets follow on from each other across the mesh, and a meshlet with nothing around
+// it left is topped up from the first face no meshlet has yet.
+class NvMeshletBuilder
+{
+public:
+	NvMeshletBuilder(size_t in_maxVertices, size_t in_maxTriangles) : maxVertices(in_maxVertices), maxTriangles(in_maxTriangles) {}
+
+	// vertices 0 to maxIndex may be used, positions as for GenerateMeshlets()
+	template<typename IndexT>
+	void Build(const IndexT* indices, size_t numIndices, size_t maxIndex,
+			   const float* positions, size_t positionStride, MeshletResult& result);
+
+private:
+	void AddFace(NvIndex face, Meshlet& meshlet, MeshletResult& result);
+	size_t NumNewVertices(const NvFaceInfo* face) const;
+	NvIndex NextFreeFace();
+	void CalcBounds(Meshlet& meshlet, const MeshletResult& result, const float* positions, size_t positionStride) const;
+
+	// the stripifier builds and owns the mesh; the faces taken are marked with the id
+	// of their meshlet as their strip id
+	NvStripifier stripifier;
+	NvMeshInfo* meshInfo = nullptr;
+
+	size_t maxVertices;
+	size_t maxTriangles;
+
+	// id of the meshlet in the making
+	int meshletId = -1;
+
+	// local index of the vertices of the meshlet in the making, and whose they are
+	std::vector<int> vertexMeshlet;
+	std::vector<uint8_t> localIndex;
+
+	// faces around the meshlet in the making, and the meshlet each was last found for
+	std::vector<NvIndex> frontier;
+	std::vector<int> frontierMeshlet;
+
+	// no face before this one is free
+	size_t firstFreeFace = 0;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
@@ -1,17 +1,154 @@
 #include "NvTriStrip.h"
+#include "IncrementalStripifier.h"
+#include "ListOptimizer.h"
+#include "MappedFile.h"
+#include "MeshChunker.h"
+#include "MeshletBuilder.h"
 #include "NvTriStripObjects.h"
+#include "OverdrawOptimizer.h"
+#include "ResultCache.h"
+#include "StripFile.h"
+#include "StripStats.h"
+#include "ThreadPool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <limits>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace nv::tristrip {
 
 ////////////////////////////////////////////////////////////////////////////////////////
 //private data
-static unsigned int cacheSize    = CACHESIZE_GEFORCE1_2;
-static bool bStitchStrips        = true;
-static unsigned int minStripSize = 0;
-static bool bListsOnly           = false;
+//options used by the GenerateStrips() overload which doesn't take any
+static StripifyOptions defaultOptions;
+
+//meshes smaller than this aren't worth starting threads for
+static constexpr size_t MIN_FACES_FOR_THREADS = 4096;
+
+//what GetLastStripifyTimings() reports
+static thread_local StripifyTimings lastTimings;
+
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStrips(const StripifyOptions& options,
+						   const InIndexT* in_indices, const size_t in_numIndices,
+						   BasicStripifyResult<OutIndexT>& result);
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStrips(const StripifyOptions& options, internal::ThreadPool* threadPool,
+						   const InIndexT* in_indices, const size_t in_numIndices,
+						   BasicStripifyResult<OutIndexT>& result);
+template<typename OutIndexT>
+static void WriteGroups(const StripifyOptions& options, internal::NvStripifier& stripifier,
+						const internal::NvStripInfoVec& strips, const internal::NvFaceInfoVec& faces,
+						internal::StripifyResultWriter<OutIndexT>& writer);
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStripsCached(const StripifyOptions& options, internal::ThreadPool* threadPool,
+								 const InIndexT* in_indices, const size_t in_numIndices,
+								 BasicStripifyResult<OutIndexT>& result);
+template<typename OutIndexT>
+static bool LoadCachedResult(const std::string& fileName, internal::StripifyResultWriter<OutIndexT>& writer);
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStripsChunked(const StripifyOptions& options, internal::ThreadPool* threadPool,
+								  const InIndexT* in_indices, const size_t in_numIndices,
+								  BasicStripifyResult<OutIndexT>& result);
+template<typename InIndexT, typename OutIndexT>
+static void GenerateOptimizedList(const StripifyOptions& options,
+								  const InIndexT* in_indices, const size_t in_numIndices,
+								  internal::StripifyResultWriter<OutIndexT>& writer);
+static void ToPrimitiveGroups(const StripifyResult& result, PrimitiveGroup** primGroups, size_t* numGroups);
+
+//the original interface reads its unsigned ints as 32 bit indices
+static_assert(std::is_same_v<unsigned int, uint32_t>);
+
+namespace internal {
+
+// Fills in a BasicStripifyResult one group at a time
+template<typename IndexT>
+struct StripifyResultWriter
+{
+	explicit StripifyResultWriter(BasicStripifyResult<IndexT>& in_result) : result(in_result) { result.Clear(); }
+
+	void BeginGroup(const PrimType type, const size_t numIndices)
+	{
+		result.types.emplace_back(type);
+
+		//reserving just enough would move all the indices for every group
+		if(result.indices.size() + numIndices > result.indices.capacity())
+			result.indices.reserve(std::max(result.indices.size() + numIndices, result.indices.capacity() * 2));
+	}
+
+	void Add(const IndexT index)
+	{
+		result.indices.emplace_back(index);
+
+		//restart indices aren't vertices, MaxIndex() only counts those
+		if(index != BasicStripifyResult<IndexT>::RESTART_INDEX)
+			result.maxIndex = std::max(result.maxIndex, index);
+	}
+
+	//adds a whole run of indices
+	void Add(const IndexT* indices, const size_t numIndices)
+	{
+		for(size_t i = 0; i < numIndices; i++)
+			Add(indices[i]);
+	}
+
+	void EndGroup() { result.starts.emplace_back(result.indices.size()); }
+
+	void SetTimings(const StripifyTimings& timings) { result.timings = timings; }
+
+	//the progressCallback stopped the call, the result stays without groups
+	void SetCancelled() { result.Clear(); result.bCancelled = true; }
+
+	BasicStripifyResult<IndexT>& result;
+};
+
+template<typename IndexT>
+static size_t MaxIndex(const IndexT* indices, const size_t numIndices)
+{
+	size_t maxIndex = 0;
+	for(size_t i = 0; i < numIndices; i++)
+	{
+		if(indices[i] > maxIndex)
+			maxIndex = indices[i];
+	}
+
+	return maxIndex;
+}
+
+//the options with the cache of their hardware profile, if they have one, in place of their own
+static StripifyOptions WithHardwareProfile(const StripifyOptions& options)
+{
+	StripifyOptions result = options;
+	if(options.hardwareProfile != nullptr)
+	{
+		result.cacheSize = options.hardwareProfile->cacheSize;
+		result.bLRUCache = options.hardwareProfile->bLRUCache;
+	}
+
+	return result;
+}
+
+//tells the progressCallback of options, if it has one, how far along the call is, and
+// returns false if it cancelled it
+static bool ReportProgress(const StripifyOptions& options, const StripifyPhase phase, const size_t done, const size_t total)
+{
+	if(options.progressCallback == nullptr)
+		return true;
+
+	return options.progressCallback(StripifyProgress(phase, done, total), options.progressUserData);
+}
+
+}  // namespace internal
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // SetListsOnly()
@@ -22,7 +159,7 @@ static bool bListsOnly           = false;
 //
 void SetListsOnly(const bool _bListsOnly)
 {
-	bListsOnly = _bListsOnly;
+	defaultOptions.bListsOnly = _bListsOnly;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -37,7 +174,7 @@ void SetListsOnly(const bool _bListsOnly)
 //
 void SetCacheSize(const unsigned int _cacheSize)
 {
-	cacheSize = _cacheSize;
+	defaultOptions.cacheSize = _cacheSize;
 }
 
 
@@ -53,7 +190,22 @@ void SetCacheSize(const unsigned int _cacheSize)
 //
 void SetStitchStrips(const bool _bStitchStrips)
 {
-	bStitchStrips = _bStitchStrips;
+	defaultOptions.bStitchStrips = _bStitchStrips;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// SetRestartStrips()
+//
+// bool to indicate whether to join strips with primitive restart indices instead.
+// If set to true, you'll get back one strip, with the restart index between the separate
+//  strips, and SetStitchStrips() has no effect.
+//
+// Default value: false
+//
+void SetRestartStrips(const bool _bRestartStrips)
+{
+	defaultOptions.bRestartStrips = _bRestartStrips;
 }
 
 
@@ -67,7 +219,7 @@ void SetStitchStrips(const bool _bStitchStrips)
 //
 void SetMinStripSize(const unsigned int _minStripSize)
 {
-	minStripSize = _minStripSize;
+	defaultOptions.minStripSize = _minStripSize;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
@@ -83,96 +235,267 @@ void SetMinStripSize(const unsigned int _minStripSize)
 void GenerateStrips(const unsigned int* in_indices, const size_t in_numIndices,
 					PrimitiveGroup** primGroups, size_t* numGroups)
 {
-	//put data in format that the stripifier likes
-	internal::UIntVec tempIndices;
-	tempIndices.resize(in_numIndices);
+	GenerateStrips(defaultOptions, in_indices, in_numIndices, primGroups, numGroups);
+}
 
-	size_t maxIndex = 0;
-	for(size_t i = 0; i < in_numIndices; i++)
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStrips()
+//
+// options: settings to stripify with
+// in_indices: input index list, the indices you would use to render
+// in_numIndices: number of entries in in_indices
+// primGroups: array of optimized/stripified PrimitiveGroups
+// numGroups: number of groups returned
+//
+// Be sure to call delete[] on the returned primGroups to avoid leaking mem
+//
+void GenerateStrips(const StripifyOptions& options,
+					const unsigned int* in_indices, const size_t in_numIndices,
+					PrimitiveGroup** primGroups, size_t* numGroups)
+{
+	StripifyResult result;
+	GenerateStrips(options, in_indices, in_numIndices, result);
+	ToPrimitiveGroups(result, primGroups, numGroups);
+
+	lastTimings = result.Timings();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStrips()
+//
+// options: settings to stripify with
+// in_indices: input index list, the indices you would use to render
+// in_numIndices: number of entries in in_indices
+// result: filled in with the optimized/stripified groups
+//
+void GenerateStrips(const StripifyOptions& options,
+					const uint16_t* in_indices, const size_t in_numIndices,
+					StripifyResult16& result)
+{
+	GenerateStrips<uint16_t, uint16_t>(options, in_indices, in_numIndices, result);
+	lastTimings = result.Timings();
+}
+
+void GenerateStrips(const StripifyOptions& options,
+					const uint16_t* in_indices, const size_t in_numIndices,
+					StripifyResult& result)
+{
+	GenerateStrips<uint16_t, uint32_t>(options, in_indices, in_numIndices, result);
+	lastTimings = result.Timings();
+}
+
+void GenerateStrips(const StripifyOptions& options,
+					const uint32_t* in_indices, const size_t in_numIndices,
+					StripifyResult& result)
+{
+	GenerateStrips<uint32_t, uint32_t>(options, in_indices, in_numIndices, result);
+	lastTimings = result.Timings();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStrips()
+//
+// Starts threads for the above if the mesh is worth it
+//
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStrips(const StripifyOptions& options,
+						   const InIndexT* in_indices, const size_t in_numIndices,
+						   BasicStripifyResult<OutIndexT>& result)
+{
+	if( (options.numThreads == 1) || (in_numIndices / 3 < MIN_FACES_FOR_THREADS) )
 	{
-		tempIndices[i] = in_indices[i];
-		if(in_indices[i] > maxIndex)
-			maxIndex = in_indices[i];
+		GenerateStrips(options, nullptr, in_indices, in_numIndices, result);
+		return;
 	}
 
-	internal::NvStripInfoVec tempStrips;
-	internal::NvFaceInfoVec tempFaces;
+	internal::ThreadPool pool(options.numThreads);
+	GenerateStrips(options, &pool, in_indices, in_numIndices, result);
+}
 
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStrips()
+//
+// Does the work of the above, running the experiments on threadPool if it isn't nullptr
+//
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStrips(const StripifyOptions& options, internal::ThreadPool* threadPool,
+						   const InIndexT* in_indices, const size_t in_numIndices,
+						   BasicStripifyResult<OutIndexT>& result)
+{
+	//everything from here on, the cached and chunked paths too, uses the cache of the profile
+	const HardwareProfile* profile = options.hardwareProfile;
+	if( (profile != nullptr) && ((options.cacheSize != profile->cacheSize) || (options.bLRUCache != profile->bLRUCache)) )
+	{
+		GenerateStrips(internal::WithHardwareProfile(options), threadPool, in_indices, in_numIndices, result);
+		return;
+	}
+
+	if(options.cacheDirectory != nullptr)
+	{
+		GenerateStripsCached(options, threadPool, in_indices, in_numIndices, result);
+		return;
+	}
+
+	if( (options.chunkSize != 0) && (in_numIndices / 3 > options.chunkSize) )
+	{
+		GenerateStripsChunked(options, threadPool, in_indices, in_numIndices, result);
+		return;
+	}
+
+	const auto start                = std::chrono::steady_clock::now();
+	const unsigned int cacheSize    = options.cacheSize;
+	const bool bRestartStrips       = options.bRestartStrips;
+	const unsigned int minStripSize = options.minStripSize;
+	const bool bListsOnly           = options.bListsOnly;
+
+	internal::StripifyResultWriter<OutIndexT> writer(result);
+	StripifyTimings timings;
+
+	if(bListsOnly && (options.listOptimizer == ListOptimizer::LO_TIPSIFY))
+	{
+		if(!internal::ReportProgress(options, StripifyPhase::SP_OPTIMIZE_LIST, 0, in_numIndices / 3))
+		{
+			writer.SetCancelled();
+			return;
+		}
+
+		GenerateOptimizedList(options, in_indices, in_numIndices, writer);
+
+		timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		writer.SetTimings(timings);
+		return;
+	}
+
+	//the stripifier reads the indices in place, it only needs to know how many vertices there are
+	size_t maxIndex = internal::MaxIndex(in_indices, in_numIndices);
+
+	//owns all the strips and faces below, so it has to outlive them
 	internal::NvStripifier stripifier;
+	stripifier.SetThreadPool(threadPool);
+	stripifier.SetCachePolicy(options.bLRUCache ? internal::CachePolicy::LRU : internal::CachePolicy::FIFO);
+	stripifier.SetRestartStrips(bRestartStrips);
+	stripifier.SetCosts(internal::StripCostsFor(options));
+	stripifier.SetProgress(options.progressCallback, options.progressUserData);
+	stripifier.SetEffort(static_cast<int>(std::min<unsigned int>(options.numSamples, std::numeric_limits<int>::max())),
+						 options.workBudget, options.bStopAtFullCover);
+
+	internal::NvStripInfoVec tempStrips;
+	internal::NvFaceInfoVec tempFaces;
 	
 	//do actual stripification
-	stripifier.Stripify(tempIndices, cacheSize, minStripSize, maxIndex, tempStrips, tempFaces);
+	stripifier.Stripify(in_indices, in_numIndices, cacheSize, minStripSize, maxIndex, tempStrips, tempFaces);
+
+	if(stripifier.Cancelled() || !internal::ReportProgress(options, StripifyPhase::SP_CREATE_STRIPS, 0, tempStrips.size()))
+	{
+		writer.SetCancelled();
+		return;
+	}
+
+	//the restart index ends each strip when they aren't stitched, a vertex can't use it
+	assert(bListsOnly || (options.bStitchStrips && !bRestartStrips) || (maxIndex < BasicStripifyResult<OutIndexT>::RESTART_INDEX));
+
+	WriteGroups(options, stripifier, tempStrips, tempFaces, writer);
+
+	const internal::NvPhaseTimes& phaseTimes = stripifier.GetPhaseTimes();
+	timings.buildStripifyInfo        = phaseTimes.buildStripifyInfo;
+	timings.findAllStrips            = phaseTimes.findAllStrips;
+	timings.splitUpStripsAndOptimize = phaseTimes.splitUpStripsAndOptimize;
+	timings.createStrips             = phaseTimes.createStrips;
+	timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	writer.SetTimings(timings);
+
+#ifdef NV_NVTS_ENABLE_PROFILING
+	if(options.profileCallback != nullptr)
+		options.profileCallback(stripifier.GetProfile(), options.profileUserData);
+#endif
 
-	//stitch strips together
-	internal::IntVec stripIndices;
-	size_t numSeparateStrips = 0;
+	//everything the stripifier allocated is freed along with it
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// WriteGroups()
+//
+// Turns the strips, and the faces left for the list, into the groups the options ask for
+//
+template<typename OutIndexT>
+static void WriteGroups(const StripifyOptions& options, internal::NvStripifier& stripifier,
+						const internal::NvStripInfoVec& strips, const internal::NvFaceInfoVec& faces,
+						internal::StripifyResultWriter<OutIndexT>& writer)
+{
+	const bool bRestartStrips = options.bRestartStrips;
+	const bool bStitchStrips  = options.bStitchStrips && !bRestartStrips;
+	const bool bListsOnly     = options.bListsOnly;
 
 	if(bListsOnly)
 	{
 		//if we're outputting only lists, we're done
-		*numGroups = 1;
-		auto* primGroupArray = new PrimitiveGroup[*numGroups];
-		(*primGroups) = primGroupArray;
-
 		//count the total number of indices
 		size_t numIndices = 0;
-		for(auto &s : tempStrips)
+		for(auto &s : strips)
 		{
 			numIndices += s->m_faces.size() * 3;
 		}
 
 		//add in the list
-		numIndices += tempFaces.size() * 3;
+		numIndices += faces.size() * 3;
 
-		auto &first      = primGroupArray[0];
-
-		first.type       = PrimType::PT_LIST;
-		first.numIndices = numIndices;
-		first.indices    = new size_t[numIndices];
+		writer.BeginGroup(PrimType::PT_LIST, numIndices);
 
 		//do strips
-		size_t indexCtr = 0;
-		for(auto &s : tempStrips)
+		for(auto &s : strips)
 		{
 			for(auto &f : s->m_faces)
 			{
 				//degenerates are of no use with lists
 				if(!internal::NvStripifier::IsDegenerate(f))
 				{
-					first.indices[indexCtr++] = f->m_v0;
-					first.indices[indexCtr++] = f->m_v1;
-					first.indices[indexCtr++] = f->m_v2;
-				}
-				else
-				{
-					//we've removed a tri, reduce the number of indices
-					first.numIndices -= 3;
+					writer.Add(static_cast<OutIndexT>(f->m_v0));
+					writer.Add(static_cast<OutIndexT>(f->m_v1));
+					writer.Add(static_cast<OutIndexT>(f->m_v2));
 				}
 			}
 		}
 
 		//do lists
-		for(auto &f : tempFaces)
+		for(auto &f : faces)
 		{
-			first.indices[indexCtr++] = f->m_v0;
-			first.indices[indexCtr++] = f->m_v1;
-			first.indices[indexCtr++] = f->m_v2;
+			writer.Add(static_cast<OutIndexT>(f->m_v0));
+			writer.Add(static_cast<OutIndexT>(f->m_v1));
+			writer.Add(static_cast<OutIndexT>(f->m_v2));
 		}
+
+		writer.EndGroup();
 	}
 	else
 	{
-		stripifier.CreateStrips(tempStrips, stripIndices, bStitchStrips, numSeparateStrips);
+		//stitch strips together
+		std::vector<OutIndexT> stripIndices;
+		size_t numSeparateStrips = 0;
+
+		//there are no strips when they were all too small, or all the faces degenerate
+		if(!strips.empty())
+			stripifier.CreateStrips(strips, stripIndices, bStitchStrips, numSeparateStrips);
 
 		//if we're stitching strips together, we better get back only one strip from CreateStrips()
-		assert( (bStitchStrips && (numSeparateStrips == 1)) || !bStitchStrips);
-		
-		//convert to output format
-		*numGroups = numSeparateStrips; //for the strips
-		if(tempFaces.size() != 0)
-			(*numGroups)++;  //we've got a list as well, increment
-		(*primGroups) = new PrimitiveGroup[*numGroups];
-		
-		PrimitiveGroup* primGroupArray = *primGroups;
+		assert( (bStitchStrips && (numSeparateStrips == 1)) || !bStitchStrips || strips.empty() );
+
+		//the separate strips go out as they are, all in one strip, but for the last restart index
+		if(bRestartStrips && !strips.empty())
+		{
+			assert(!stripIndices.empty() && (stripIndices.back() == internal::STRIP_RESTART_INDEX<OutIndexT>));
+			stripIndices.pop_back();
+
+			writer.BeginGroup(PrimType::PT_STRIP, stripIndices.size());
+			writer.Add(stripIndices.data(), stripIndices.size());
+			writer.EndGroup();
+
+			numSeparateStrips = 0;
+		}
 		
 		//first, the strips
 		size_t startingLoc = 0;
@@ -186,7 +509,7 @@ void GenerateStrips(const unsigned int* in_indices, const size_t in_numIndices,
 				size_t i;
 				for(i = startingLoc; i < stripIndices.size(); i++)
 				{
-					if(stripIndices[i] == -1)
+					if(stripIndices[i] == internal::STRIP_RESTART_INDEX<OutIndexT>)
 						break;
 				}
 				
@@ -196,64 +519,877 @@ void GenerateStrips(const unsigned int* in_indices, const size_t in_numIndices,
 			else
 				stripLength = stripIndices.size();
 			
-			auto &strip      = primGroupArray[stripCtr];
+			writer.BeginGroup(PrimType::PT_STRIP, stripLength);
+			writer.Add(stripIndices.data() + startingLoc, stripLength);
+			writer.EndGroup();
 
-			strip.type       = PrimType::PT_STRIP;
-			strip.indices    = new size_t[stripLength];
-			strip.numIndices = stripLength;
-			
-			size_t indexCtr = 0;
-			for(size_t i = startingLoc; i < stripLength + startingLoc; i++)
-				strip.indices[indexCtr++] = stripIndices[i];
-
-			//we add 1 to account for the -1 separating strips
+			//we add 1 to account for the restart index separating strips
 			//this doesn't break the stitched case since we'll exit the loop
 			startingLoc += stripLength + 1; 
 		}
 		
 		//next, the list
-		if(tempFaces.size() != 0)
+		if(faces.size() != 0)
 		{
-			assert(*numGroups >= 1);
+			writer.BeginGroup(PrimType::PT_LIST, faces.size() * 3);
+			for(auto &f : faces)
+			{
+				writer.Add(static_cast<OutIndexT>(f->m_v0));
+				writer.Add(static_cast<OutIndexT>(f->m_v1));
+				writer.Add(static_cast<OutIndexT>(f->m_v2));
+			}
+			writer.EndGroup();
+		}
+	}
+}
 
-			size_t faceGroupLoc = (*numGroups) - 1;    //the face group is the last one
-			
-			auto &strip      = primGroupArray[faceGroupLoc];
 
-			strip.type       = PrimType::PT_LIST;
-			strip.indices    = new size_t[tempFaces.size() * 3];
-			strip.numIndices = tempFaces.size() * 3;
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsCached()
+//
+// GenerateStrips() for options with a cacheDirectory: reads the result back from there if
+//  it was stored before, or works it out and stores it for next time
+//
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStripsCached(const StripifyOptions& options, internal::ThreadPool* threadPool,
+								 const InIndexT* in_indices, const size_t in_numIndices,
+								 BasicStripifyResult<OutIndexT>& result)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const std::string fileName = internal::CacheFileName(options.cacheDirectory, options, sizeof(OutIndexT),
+														 in_indices, in_numIndices);
+
+	internal::StripifyResultWriter<OutIndexT> writer(result);
+	if(LoadCachedResult(fileName, writer))
+	{
+		StripifyTimings timings;
+		timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		writer.SetTimings(timings);
+		return;
+	}
+
+	StripifyOptions uncachedOptions = options;
+	uncachedOptions.cacheDirectory = nullptr;
+	GenerateStrips(uncachedOptions, threadPool, in_indices, in_numIndices, result);
+
+	//a cancelled result isn't the one for these options
+	if(!result.Cancelled())
+		internal::StoreCacheFile(fileName, result);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// LoadCachedResult()
+//
+// Fills in the result from a strip file of the cache, returns false without adding
+//  anything if there is none, or it isn't what the result needs
+//
+template<typename OutIndexT>
+static bool LoadCachedResult(const std::string& fileName, internal::StripifyResultWriter<OutIndexT>& writer)
+{
+	internal::MappedFile file;
+	internal::StripFileContents contents;
+	if( !file.Open(fileName.c_str()) || !internal::ParseStripFile(file.Data(), file.Size(), contents) ||
+		(contents.indexSize != sizeof(OutIndexT)) )
+		return false;
+
+	const auto* indices = static_cast<const OutIndexT*>(contents.indices);
+	for(size_t i = 0; i < contents.numGroups; i++)
+	{
+		const size_t numIndices = static_cast<size_t>(contents.groups[i].numIndices);
+
+		writer.BeginGroup(static_cast<PrimType>(contents.groups[i].type), numIndices);
+		writer.Add(indices, numIndices);
+		writer.EndGroup();
+
+		indices += numIndices;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsChunked()
+//
+// GenerateStrips() for a mesh with more than options.chunkSize triangles: stripifies each
+//  run of chunkSize triangles as a mesh of its own, on threadPool if it isn't nullptr, and
+//  joins their groups up in order, so the result doesn't depend on the number of threads
+//
+template<typename InIndexT, typename OutIndexT>
+static void GenerateStripsChunked(const StripifyOptions& options, internal::ThreadPool* threadPool,
+								  const InIndexT* in_indices, const size_t in_numIndices,
+								  BasicStripifyResult<OutIndexT>& result)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	//a copy of a face in another chunk than the face wouldn't be found by its stripifier,
+	// so they all go before the mesh is cut up
+	std::vector<InIndexT> uniqueIndices;
+	const InIndexT* meshIndices = in_indices;
+	size_t numMeshIndices       = in_numIndices;
+	if(internal::RemoveDuplicateFaces(in_indices, in_numIndices, uniqueIndices))
+	{
+		meshIndices    = uniqueIndices.data();
+		numMeshIndices = uniqueIndices.size();
+	}
+
+	const size_t numTriangles = numMeshIndices / 3;
+	const size_t chunkSize    = options.chunkSize;
+	const size_t numChunks    = (numTriangles + chunkSize - 1) / chunkSize;
+
+	//the chunks are small enough to go through in one piece, and on one thread each.
+	// a chunk which waited on experiments of its own could pick up another chunk meanwhile,
+	// and have more of them held at once than there are threads
+	StripifyOptions chunkOptions = options;
+	chunkOptions.chunkSize = 0;
+
+	//the chunks themselves only ask whether to go on, the chunks done so far are reported
+	// one at a time, as they come in
+	struct ChunkProgress
+	{
+		std::atomic<bool> bCancelled{false};
+		std::mutex mutex;
+		size_t numDone = 0;
+	} progress;
+
+	if(!internal::ReportProgress(options, StripifyPhase::SP_CHUNKS, 0, numChunks))
+		progress.bCancelled.store(true);
 
-			size_t indexCtr = 0;
-			for(auto &f : tempFaces)
+	chunkOptions.progressCallback = [](const StripifyProgress&, void* userData) {
+		return !static_cast<ChunkProgress*>(userData)->bCancelled.load(std::memory_order_relaxed);
+	};
+	chunkOptions.progressUserData = &progress;
+
+	struct Chunk
+	{
+		std::vector<uint32_t> vertices;  // local --> original index
+		StripifyResult result;
+	};
+	std::vector<Chunk> chunks(numChunks);
+
+	auto runChunk = [&](const size_t c) {
+		if(progress.bCancelled.load(std::memory_order_relaxed))
+			return;
+
+		const size_t first = c * chunkSize;
+		const size_t count = std::min(chunkSize, numTriangles - first);
+
+		std::vector<uint32_t> localIndices;
+		internal::CompactChunk(meshIndices + first * 3, count * 3, localIndices, chunks[c].vertices);
+		GenerateStrips(chunkOptions, nullptr, localIndices.data(), localIndices.size(), chunks[c].result);
+
+		std::lock_guard<std::mutex> lock(progress.mutex);
+		progress.numDone++;
+		if( chunks[c].result.Cancelled() ||
+			!internal::ReportProgress(options, StripifyPhase::SP_CHUNKS, progress.numDone, numChunks) )
+			progress.bCancelled.store(true, std::memory_order_relaxed);
+	};
+
+	if(threadPool == nullptr)
+	{
+		for(size_t c = 0; c < numChunks; c++)
+			runChunk(c);
+	}
+	else
+	{
+		internal::TaskGroup group(*threadPool);
+		for(size_t c = 0; c < numChunks; c++)
+			group.Run([&runChunk, c] { runChunk(c); });
+		group.Wait();
+	}
+
+	internal::StripifyResultWriter<OutIndexT> writer(result);
+	if(progress.bCancelled.load())
+	{
+		writer.SetCancelled();
+		return;
+	}
+
+	//back to the original indices, restart indices turn into ours
+	auto addChunkIndices = [](internal::StripifyResultWriter<OutIndexT>& writer, const Chunk& chunk, const size_t group) {
+		const uint32_t* indices = chunk.result.Indices() + chunk.result.GroupStart(group);
+		for(size_t i = 0; i < chunk.result.NumIndices(group); i++)
+		{
+			if(indices[i] == StripifyResult::RESTART_INDEX)
+				writer.Add(BasicStripifyResult<OutIndexT>::RESTART_INDEX);
+			else
+				writer.Add(static_cast<OutIndexT>(chunk.vertices[indices[i]]));
+		}
+	};
+
+	StripifyTimings timings;
+
+	//the strips first, stitched or restarted into one strip unless they are separate
+	const bool bJoinStrips = !options.bListsOnly && (options.bStitchStrips || options.bRestartStrips);
+	if(!options.bListsOnly)
+	{
+		if(bJoinStrips)
+			writer.BeginGroup(PrimType::PT_STRIP, 0);
+
+		size_t joinedStart = result.NumIndices();
+		for(auto &chunk : chunks)
+		{
+			for(size_t g = 0; g < chunk.result.NumGroups(); g++)
 			{
-				strip.indices[indexCtr++] = f->m_v0;
-				strip.indices[indexCtr++] = f->m_v1;
-				strip.indices[indexCtr++] = f->m_v2;
+				const size_t numIndices = chunk.result.NumIndices(g);
+				if( (chunk.result.GroupType(g) != PrimType::PT_STRIP) || (numIndices == 0) )
+					continue;
+
+				if(!bJoinStrips)
+				{
+					writer.BeginGroup(PrimType::PT_STRIP, numIndices);
+					addChunkIndices(writer, chunk, g);
+					writer.EndGroup();
+					continue;
+				}
+
+				const size_t joinedLength = result.NumIndices() - joinedStart;
+				if(joinedLength != 0)
+				{
+					const OutIndexT first = static_cast<OutIndexT>(chunk.vertices[chunk.result.Indices()[chunk.result.GroupStart(g)]]);
+					if(options.bRestartStrips)
+						writer.Add(BasicStripifyResult<OutIndexT>::RESTART_INDEX);
+					else
+					{
+						//double tap the last and first, and once more if the chunk's strip
+						// would start on an odd index, with its winding flipped
+						writer.Add(result.Indices()[result.NumIndices() - 1]);
+						writer.Add(first);
+						if(joinedLength % 2 != 0)
+							writer.Add(first);
+					}
+				}
+
+				addChunkIndices(writer, chunk, g);
 			}
 		}
+
+		if(bJoinStrips)
+			writer.EndGroup();
 	}
 
-	//clean up everything
+	//then everything which didn't go into strips, all in one list
+	size_t numListIndices = 0;
+	for(auto &chunk : chunks)
+	{
+		for(size_t g = 0; g < chunk.result.NumGroups(); g++)
+		{
+			if(chunk.result.GroupType(g) == PrimType::PT_LIST)
+				numListIndices += chunk.result.NumIndices(g);
+		}
+	}
 
-	//delete strips
-	for(auto &s : tempStrips)
+	std::vector<uint32_t> listIndices;
+	listIndices.reserve(numListIndices);
+	for(auto &chunk : chunks)
 	{
-		for(auto &f : s->m_faces)
+		for(size_t g = 0; g < chunk.result.NumGroups(); g++)
 		{
-			delete f;
-			f = nullptr;
+			if(chunk.result.GroupType(g) != PrimType::PT_LIST)
+				continue;
+
+			const uint32_t* indices = chunk.result.Indices() + chunk.result.GroupStart(g);
+			for(size_t i = 0; i < chunk.result.NumIndices(g); i++)
+				listIndices.emplace_back(chunk.vertices[indices[i]]);
 		}
-		delete s;
-		s = nullptr;
+
+		const StripifyTimings& chunkTimings = chunk.result.Timings();
+		timings.buildStripifyInfo        += chunkTimings.buildStripifyInfo;
+		timings.findAllStrips            += chunkTimings.findAllStrips;
+		timings.splitUpStripsAndOptimize += chunkTimings.splitUpStripsAndOptimize;
+		timings.createStrips             += chunkTimings.createStrips;
+
+		chunk = Chunk();
+	}
+
+	//the leftovers of the chunks, boundaries and all, are ordered for the cache together.
+	// lists only output is made of whole chunks, each already in cache order
+	if(!options.bListsOnly && !listIndices.empty())
+	{
+		std::vector<uint32_t> localIndices;
+		std::vector<uint32_t> vertices;
+		internal::CompactChunk(listIndices.data(), listIndices.size(), localIndices, vertices);
+
+		std::vector<uint32_t> ordered;
+		internal::OptimizeListForCache(localIndices.data(), localIndices.size(), vertices.size(), options.cacheSize,
+									   options.bLRUCache ? internal::CachePolicy::LRU : internal::CachePolicy::FIFO,
+									   ordered);
+
+		for(size_t i = 0; i < ordered.size(); i++)
+			listIndices[i] = vertices[ordered[i]];
+		listIndices.resize(ordered.size());
 	}
 
-	//delete faces
-	for(auto &f : tempFaces)
+	if(options.bListsOnly || !listIndices.empty())
 	{
-		delete f;
-		f = nullptr;
+		writer.BeginGroup(PrimType::PT_LIST, listIndices.size());
+		for(auto index : listIndices)
+			writer.Add(static_cast<OutIndexT>(index));
+		writer.EndGroup();
 	}
+
+	timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	writer.SetTimings(timings);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateOptimizedList()
+//
+// Lists only output straight from the list optimizer, without building any strips
+//
+template<typename InIndexT, typename OutIndexT>
+static void GenerateOptimizedList(const StripifyOptions& options,
+								  const InIndexT* in_indices, const size_t in_numIndices,
+								  internal::StripifyResultWriter<OutIndexT>& writer)
+{
+	std::vector<InIndexT> listIndices;
+	internal::OptimizeListForCache(in_indices, in_numIndices,
+								   (in_numIndices != 0) ? internal::MaxIndex(in_indices, in_numIndices) + 1 : 0,
+								   options.cacheSize,
+								   options.bLRUCache ? internal::CachePolicy::LRU : internal::CachePolicy::FIFO,
+								   listIndices);
+
+	writer.BeginGroup(PrimType::PT_LIST, listIndices.size());
+	for(auto index : listIndices)
+		writer.Add(index);
+	writer.EndGroup();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// ToPrimitiveGroups()
+//
+// Copies the groups of result out into the new[]'d PrimitiveGroups the original
+//  interface hands back
+//
+static void ToPrimitiveGroups(const StripifyResult& result, PrimitiveGroup** primGroups, size_t* numGroups)
+{
+	*numGroups = result.NumGroups();
+	(*primGroups) = new PrimitiveGroup[*numGroups];
+
+	for(size_t i = 0; i < result.NumGroups(); i++)
+	{
+		auto &group      = (*primGroups)[i];
+
+		group.type       = result.GroupType(i);
+		group.numIndices = result.NumIndices(i);
+		group.indices    = new size_t[group.numIndices];
+
+		result.CopyIndices(i, group.indices);
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GetLastStripifyTimings()
+//
+void GetLastStripifyTimings(StripifyTimings* timings)
+{
+	*timings = lastTimings;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsBatch()
+//
+// options: settings to stripify every mesh with
+// meshes: array of meshes, see StripifyBatchMesh
+// numMeshes: number of entries in meshes
+//
+void GenerateStripsBatch(const StripifyOptions& options,
+						 StripifyBatchMesh* meshes, const size_t numMeshes)
+{
+	if(numMeshes == 0)
+		return;
+
+	//biggest meshes first, so the long ones don't end up being started last
+	std::vector<size_t> order(numMeshes);
+	std::iota(std::begin(order), std::end(order), size_t{0});
+	std::stable_sort(std::begin(order), std::end(order),
+		[meshes](size_t a, size_t b) noexcept {
+			return meshes[a].numIndices > meshes[b].numIndices;
+		});
+
+	internal::ThreadPool pool(options.numThreads);
+	internal::TaskGroup group(pool);
+
+	//the pool deals these round robin, so each thread starts on one of the biggest meshes.
+	// the experiments of each mesh go into the same pool, so once the meshes run out
+	// the threads left over help with the ones still going
+	for(auto i : order)
+	{
+		group.Run([&options, &pool, &mesh = meshes[i]] {
+			StripifyResult result;
+			GenerateStrips(options, &pool, mesh.indices, mesh.numIndices, result);
+			ToPrimitiveGroups(result, &mesh.primGroups, &mesh.numGroups);
+		});
+	}
+
+	group.Wait();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsFile()
+//
+// Stripifies in_indices, straight out of the index file, into file
+//
+template<typename IndexT>
+static bool GenerateStripsFile(const StripifyOptions& options,
+							   const IndexT* in_indices, const size_t in_numIndices, std::FILE* file)
+{
+	//nothing on disk has been through the asserts of the callers of GenerateStrips()
+	const bool bSeparateStrips = !options.bListsOnly && (!options.bStitchStrips || options.bRestartStrips);
+	if( bSeparateStrips && (in_numIndices != 0) &&
+		(internal::MaxIndex(in_indices, in_numIndices) >= BasicStripifyResult<IndexT>::RESTART_INDEX) )
+		return false;
+
+	BasicStripifyResult<IndexT> result;
+	GenerateStrips(options, in_indices, in_numIndices, result);
+	return internal::WriteStripFile(file, result);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsFile()
+//
+// options: settings to stripify with
+// in_fileName: index file to read
+// in_format: what it looks like
+// out_fileName: strip file to write
+//
+bool GenerateStripsFile(const StripifyOptions& options,
+						const char* in_fileName, const IndexFileFormat in_format,
+						const char* out_fileName)
+{
+	internal::MappedFile inFile;
+	internal::IndexFileContents contents;
+	if( !inFile.Open(in_fileName) || !internal::ParseIndexFile(inFile.Data(), inFile.Size(), in_format, contents) )
+		return false;
+
+	std::FILE* outFile = std::fopen(out_fileName, "wb");
+	if(outFile == nullptr)
+		return false;
+
+	bool bWritten;
+	if(contents.indexSize == 2)
+		bWritten = GenerateStripsFile(options, static_cast<const uint16_t*>(contents.indices), contents.numIndices, outFile);
+	else
+		bWritten = GenerateStripsFile(options, static_cast<const uint32_t*>(contents.indices), contents.numIndices, outFile);
+
+	//closing flushes, so it has a say in whether everything made it out
+	bWritten = (std::fclose(outFile) == 0) && bWritten;
+	if(!bWritten)
+		std::remove(out_fileName);
+
+	return bWritten;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// IncrementalStripifier
+//
+IncrementalStripifier::IncrementalStripifier() : stripifier(new internal::NvIncrementalStripifier) {}
+
+IncrementalStripifier::~IncrementalStripifier()
+{
+	delete stripifier;
+}
+
+void IncrementalStripifier::SetMesh(const StripifyOptions& in_options, const uint32_t* in_indices, const size_t in_numIndices)
+{
+	options = internal::WithHardwareProfile(in_options);
+	stripifier->Reset(options);
+	stripifier->AddTriangles(in_indices, in_numIndices);
+}
+
+size_t IncrementalStripifier::AddTriangles(const uint32_t* in_indices, const size_t in_numIndices)
+{
+	return stripifier->AddTriangles(in_indices, in_numIndices);
+}
+
+bool IncrementalStripifier::RemoveTriangles(const size_t* triangles, const size_t numTriangles)
+{
+	return stripifier->RemoveTriangles(triangles, numTriangles);
+}
+
+size_t IncrementalStripifier::NumTriangles() const
+{
+	return stripifier->NumTriangles();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Update()
+//
+// Only the faces which changed are stripified, but all the groups are written out again,
+//  starting threads if enough faces changed to be worth it
+//
+void IncrementalStripifier::Update(StripifyResult& result)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	internal::StripifyResultWriter<uint32_t> writer(result);
+	StripifyTimings timings;
+
+	if(options.bListsOnly && (options.listOptimizer == ListOptimizer::LO_TIPSIFY))
+	{
+		std::vector<uint32_t> indices;
+		stripifier->GetTriangles(indices);
+		GenerateOptimizedList(options, indices.data(), indices.size(), writer);
+
+		timings.buildStripifyInfo = stripifier->EditTime();
+		stripifier->Update(nullptr);
+
+		timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		writer.SetTimings(timings);
+		return;
+	}
+
+	if( (options.numThreads == 1) || (stripifier->NumChangedFaces() < MIN_FACES_FOR_THREADS) )
+		stripifier->Update(nullptr);
+	else
+	{
+		internal::ThreadPool pool(options.numThreads);
+		stripifier->Update(&pool);
+	}
+
+	//the restart index ends each strip when they aren't stitched, a vertex can't use it
+	assert(options.bListsOnly || (options.bStitchStrips && !options.bRestartStrips) ||
+		   (stripifier->MaxIndex() < StripifyResult::RESTART_INDEX));
+
+	internal::NvStripifier& nvStripifier = stripifier->Stripifier();
+	WriteGroups(options, nvStripifier, stripifier->Strips(), stripifier->ListFaces(), writer);
+
+	const internal::NvPhaseTimes& phaseTimes = nvStripifier.GetPhaseTimes();
+	timings.buildStripifyInfo        = phaseTimes.buildStripifyInfo;
+	timings.findAllStrips            = phaseTimes.findAllStrips;
+	timings.splitUpStripsAndOptimize = phaseTimes.splitUpStripsAndOptimize;
+	timings.createStrips             = phaseTimes.createStrips;
+	timings.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	writer.SetTimings(timings);
+
+#ifdef NV_NVTS_ENABLE_PROFILING
+	if(options.profileCallback != nullptr)
+		options.profileCallback(nvStripifier.GetProfile(), options.profileUserData);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyTask
+//
+namespace internal {
+
+// What a StripifyTask shares with the thread running its call
+struct StripifyTaskState
+{
+	std::thread thread;
+	std::atomic<bool> bCancelRequested{false};
+	std::atomic<bool> bCancelled{false};
+	std::atomic<bool> bDone{true};
+
+	//the options of the call, whose progressCallback is chained after our own
+	StripifyOptions options;
+
+	mutable std::mutex mutex;
+	StripifyProgress progress;
+
+	StripifyResult result;
+
+	//keeps the progress for Progress(), and stops the call once it has been cancelled
+	static bool Report(const StripifyProgress& in_progress, void* userData)
+	{
+		auto* state = static_cast<StripifyTaskState*>(userData);
+
+		//the chunks of a mesh report one at a time, but the lock is cheap anyway
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->progress = in_progress;
+
+		if( !state->bCancelRequested.load() && !ReportProgress(state->options, in_progress.phase, in_progress.done, in_progress.total) )
+			state->bCancelRequested.store(true);
+
+		return !state->bCancelRequested.load();
+	}
+
+	void Join()
+	{
+		if(thread.joinable())
+			thread.join();
+	}
+};
+
+}  // namespace internal
+
+StripifyTask::StripifyTask() : state(new internal::StripifyTaskState) {}
+
+StripifyTask::~StripifyTask()
+{
+	Cancel();
+	state->Join();
+	delete state;
+}
+
+void StripifyTask::Cancel()
+{
+	state->bCancelRequested.store(true);
+}
+
+bool StripifyTask::IsDone() const
+{
+	return state->bDone.load();
+}
+
+void StripifyTask::Wait()
+{
+	state->Join();
+}
+
+StripifyProgress StripifyTask::Progress() const
+{
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->progress;
+}
+
+bool StripifyTask::Cancelled() const
+{
+	return state->bCancelled.load();
+}
+
+StripifyResult& StripifyTask::Result()
+{
+	return state->result;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsAsync()
+//
+// options: settings to stripify with
+// in_indices: input index list, which has to stay alive until the task is done
+// in_numIndices: number of entries in in_indices
+// task: where the call runs
+//
+void GenerateStripsAsync(const StripifyOptions& options,
+						 const uint32_t* in_indices, const size_t in_numIndices,
+						 StripifyTask& task)
+{
+	internal::StripifyTaskState& state = *task.state;
+
+	//one call at a time
+	task.Cancel();
+	state.Join();
+
+	state.bCancelRequested.store(false);
+	state.bCancelled.store(false);
+	state.bDone.store(false);
+	state.options  = options;
+	state.progress = StripifyProgress();
+	state.result.Clear();
+
+	StripifyOptions taskOptions = options;
+	taskOptions.progressCallback = internal::StripifyTaskState::Report;
+	taskOptions.progressUserData = &state;
+
+	state.thread = std::thread([&state, taskOptions, in_indices, in_numIndices] {
+		GenerateStrips(taskOptions, in_indices, in_numIndices, state.result);
+
+		state.bCancelled.store(state.result.Cancelled());
+		state.bDone.store(true);
+	});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+// CalcStripifyStats()
+//
+// primGroups/result: the groups to measure
+// numGroups: number of entries in primGroups
+// cacheSize: number of vertices in the cache
+// bLRUCache: the cache throws out the least recently used vertex instead of the oldest
+// stats: filled in with the results
+//
+static void FillStats(const internal::StripStatsCounter& counter, StripifyStats* stats)
+{
+	stats->numIndices     = counter.NumIndices();
+	stats->numTriangles   = counter.NumTriangles();
+	stats->numDegenerates = counter.NumDegenerates();
+	stats->numStrips      = counter.NumStrips();
+	stats->numVertices    = counter.NumVertices();
+	stats->numCacheMisses = counter.NumCacheMisses();
+
+	stats->acmr = (counter.NumTriangles() != 0) ? (float)counter.NumCacheMisses() / (float)counter.NumTriangles() : 0.0f;
+	stats->atvr = (counter.NumVertices() != 0) ? (float)counter.NumCacheMisses() / (float)counter.NumVertices() : 0.0f;
+	stats->avgStripLength = (counter.NumStrips() != 0) ? (float)counter.NumStripTriangles() / (float)counter.NumStrips() : 0.0f;
+}
+
+template<typename IndexT>
+static void CalcStripifyStats(const BasicStripifyResult<IndexT>& result,
+							  const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats)
+{
+	internal::StripStatsCounter counter(cacheSize, bLRUCache ? internal::CachePolicy::LRU : internal::CachePolicy::FIFO);
+	for(size_t i = 0; i < result.NumGroups(); i++)
+	{
+		const IndexT* indices = result.Indices() + result.GroupStart(i);
+		if(result.GroupType(i) == PrimType::PT_LIST)
+			counter.AddList(indices, result.NumIndices(i));
+		else if(result.GroupType(i) == PrimType::PT_FAN)
+			counter.AddFan(indices, result.NumIndices(i));
+		else
+			counter.AddStrip(indices, result.NumIndices(i), BasicStripifyResult<IndexT>::RESTART_INDEX);
+	}
+
+	FillStats(counter, stats);
+}
+
+void CalcStripifyStats(const PrimitiveGroup* primGroups, const size_t numGroups,
+					   const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats)
+{
+	internal::StripStatsCounter counter(cacheSize, bLRUCache ? internal::CachePolicy::LRU : internal::CachePolicy::FIFO);
+	for(size_t i = 0; i < numGroups; i++)
+	{
+		const PrimitiveGroup &group = primGroups[i];
+		if(group.type == PrimType::PT_LIST)
+			counter.AddList(group.indices, group.numIndices);
+		else if(group.type == PrimType::PT_FAN)
+			counter.AddFan(group.indices, group.numIndices);
+		else
+			counter.AddStrip(group.indices, group.numIndices, size_t{StripifyResult::RESTART_INDEX});
+	}
+
+	FillStats(counter, stats);
+}
+
+void CalcStripifyStats(const StripifyResult16& result,
+					   const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats)
+{
+	CalcStripifyStats<uint16_t>(result, cacheSize, bLRUCache, stats);
+}
+
+void CalcStripifyStats(const StripifyResult& result,
+					   const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats)
+{
+	CalcStripifyStats<uint32_t>(result, cacheSize, bLRUCache, stats);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// ReduceOverdraw()
+//
+// options: settings the groups were generated with, for the cache size and policy
+// primGroups: array of PrimitiveGroups to reorder
+// numGroups: number of entries in primGroups
+// positions: x, y, z of the first vertex, each vertex positionStride bytes after the last
+// numVerts: number of vertices in positions
+// maxACMRRatio: how much worse the cache may do, 1.05 is 5% more misses
+//
+bool ReduceOverdraw(const StripifyOptions& options,
+					PrimitiveGroup* primGroups, const size_t numGroups,
+					const float* positions, const size_t positionStride, const size_t numVerts,
+					const float maxACMRRatio)
+{
+	bool bReordered = false;
+	for(size_t i = 0; i < numGroups; i++)
+	{
+		PrimitiveGroup &group = primGroups[i];
+		if(group.type != PrimType::PT_LIST)
+			continue;
+
+		//the positions of a vertex past numVerts aren't there to read
+		if( (group.numIndices != 0) && (internal::MaxIndex(group.indices, group.numIndices) >= numVerts) )
+			continue;
+
+		if(internal::ReorderListForOverdraw(group.indices, group.numIndices, positions, positionStride, numVerts,
+											options.cacheSize,
+											options.bLRUCache ? internal::CachePolicy::LRU : internal::CachePolicy::FIFO,
+											maxACMRRatio))
+			bReordered = true;
+	}
+
+	return bReordered;
+}
+
+
+template<typename IndexT>
+static bool SortTrianglesSpatially(IndexT* in_indices, const size_t in_numIndices,
+								   const float* positions, const size_t positionStride, const size_t numVerts)
+{
+	if( (in_numIndices != 0) && (internal::MaxIndex(in_indices, in_numIndices) >= numVerts) )
+		return false;
+
+	internal::SortTrianglesSpatially(in_indices, in_numIndices, positions, positionStride);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// SortTrianglesSpatially()
+//
+// in_indices: index list to reorder
+// in_numIndices: number of entries in in_indices
+// positions: x, y, z of the first vertex, each vertex positionStride bytes after the last
+// numVerts: number of vertices in positions
+//
+bool SortTrianglesSpatially(uint16_t* in_indices, const size_t in_numIndices,
+							const float* positions, const size_t positionStride, const size_t numVerts)
+{
+	return SortTrianglesSpatially<uint16_t>(in_indices, in_numIndices, positions, positionStride, numVerts);
+}
+
+bool SortTrianglesSpatially(uint32_t* in_indices, const size_t in_numIndices,
+							const float* positions, const size_t positionStride, const size_t numVerts)
+{
+	return SortTrianglesSpatially<uint32_t>(in_indices, in_numIndices, positions, positionStride, numVerts);
+}
+
+
+template<typename IndexT>
+static bool GenerateMeshlets(const MeshletOptions& options,
+							 const IndexT* in_indices, const size_t in_numIndices,
+							 const float* positions, const size_t positionStride, const size_t numVerts,
+							 MeshletResult& result)
+{
+	result.Clear();
+
+	//the local indices are bytes
+	if( (options.maxVertices < 3) || (options.maxVertices > 256) || (options.maxTriangles < 1) )
+		return false;
+
+	size_t maxIndex = internal::MaxIndex(in_indices, in_numIndices);
+	if( (in_numIndices != 0) && (maxIndex >= numVerts) )
+		return false;
+
+	internal::NvMeshletBuilder builder(options.maxVertices, options.maxTriangles);
+	builder.Build(in_indices, in_numIndices, maxIndex, positions, positionStride, result);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateMeshlets()
+//
+// options: how big the meshlets may get
+// in_indices: input index list, the indices you would use to render
+// in_numIndices: number of entries in in_indices
+// positions: x, y, z of the first vertex, each vertex positionStride bytes after the last,
+//  or nullptr to leave the bounds at 0
+// numVerts: number of vertices in positions
+// result: filled in with the meshlets
+//
+bool GenerateMeshlets(const MeshletOptions& options,
+					  const uint16_t* in_indices, const size_t in_numIndices,
+					  const float* positions, const size_t positionStride, const size_t numVerts,
+					  MeshletResult& result)
+{
+	return GenerateMeshlets<uint16_t>(options, in_indices, in_numIndices, positions, positionStride, numVerts, result);
+}
+
+bool GenerateMeshlets(const MeshletOptions& options,
+					  const uint32_t* in_indices, const size_t in_numIndices,
+					  const float* positions, const size_t positionStride, const size_t numVerts,
+					  MeshletResult& result)
+{
+	return GenerateMeshlets<uint32_t>(options, in_indices, in_numIndices, positions, positionStride, numVerts, result);
 }
 
 
@@ -274,10 +1410,26 @@ void GenerateStrips(const unsigned int* in_indices, const size_t in_numIndices,
 void RemapIndices(const PrimitiveGroup* in_primGroups, const size_t numGroups,
 				  const size_t numVerts, PrimitiveGroup** remappedGroups)
 {
+	//caches oldIndex --> newIndex conversion
+	std::vector<size_t> indexCache(numVerts);
+	RemapIndices(in_primGroups, numGroups, numVerts, remappedGroups, indexCache.data());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RemapIndices()
+//
+// Same as above, filling in remapTable with oldIndex --> newIndex as it goes
+//
+size_t RemapIndices(const PrimitiveGroup* in_primGroups, const size_t numGroups,
+					const size_t numVerts, PrimitiveGroup** remappedGroups, size_t* remapTable)
+{
+	//the restart index of PrimitiveGroups, see SetRestartStrips()
+	constexpr size_t RESTART_INDEX = StripifyResult::OutRestartIndex<size_t>();
+
 	(*remappedGroups) = new PrimitiveGroup[numGroups];
 
-	//caches oldIndex --> newIndex conversion
-	std::vector<size_t> indexCache{numVerts, std::numeric_limits<size_t>::max(), std::allocator<size_t>()};
+	std::fill(remapTable, remapTable + numVerts, REMAP_UNUSED);
 	
 	//loop over primitive groups
 	size_t indexCtr = 0;
@@ -292,14 +1444,21 @@ void RemapIndices(const PrimitiveGroup* in_primGroups, const size_t numGroups,
 
 		for(size_t j = 0; j < numIndices; j++)
 		{
-			size_t cachedIndex = indexCache[in_primGroups[i].indices[j]];
-			if(cachedIndex == std::numeric_limits<size_t>::max()) //we haven't seen this index before
+			//restart indices aren't vertices, they go through as they are
+			if( (in_primGroups[i].type == PrimType::PT_STRIP) && (in_primGroups[i].indices[j] == RESTART_INDEX) )
+			{
+				(*remappedGroups)[i].indices[j] = RESTART_INDEX;
+				continue;
+			}
+
+			size_t cachedIndex = remapTable[in_primGroups[i].indices[j]];
+			if(cachedIndex == REMAP_UNUSED) //we haven't seen this index before
 			{
 				//point to "last" vertex in VB
 				(*remappedGroups)[i].indices[j] = indexCtr;
 
 				//add to index cache, increment
-				indexCache[in_primGroups[i].indices[j]] = indexCtr++;
+				remapTable[in_primGroups[i].indices[j]] = indexCtr++;
 			}
 			else
 			{
@@ -308,6 +1467,76 @@ void RemapIndices(const PrimitiveGroup* in_primGroups, const size_t numGroups,
 			}
 		}
 	}
+
+	return indexCtr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RemapVertices()
+//
+// vertices: the vertex buffer, vertex i starts i * stride bytes in
+// stride: size of each vertex in bytes
+// numVerts: number of vertices in vertices, and entries in remapTable
+// remapTable: old index --> new index, as filled in by RemapIndices()
+// out_vertices: buffer to write the reordered vertices into, or nullptr for in place
+//
+size_t RemapVertices(void* vertices, const size_t stride, const size_t numVerts,
+					 const size_t* remapTable, void* out_vertices)
+{
+	auto* data = static_cast<unsigned char*>(vertices);
+
+	size_t numUsed = 0;
+	for(size_t i = 0; i < numVerts; i++)
+	{
+		if(remapTable[i] != REMAP_UNUSED)
+		{
+			assert(remapTable[i] < numVerts);
+			++numUsed;
+		}
+	}
+
+	if(out_vertices != nullptr)
+	{
+		auto* out = static_cast<unsigned char*>(out_vertices);
+		for(size_t i = 0; i < numVerts; i++)
+		{
+			if(remapTable[i] != REMAP_UNUSED)
+				std::memcpy(out + remapTable[i] * stride, data + i * stride, stride);
+		}
+
+		return numUsed;
+	}
+
+	//in place, follow each chain of vertices carrying one along, till we land on a slot
+	// which no longer holds a vertex something still needs
+	std::vector<bool> bMoved(numVerts, false);
+	std::vector<unsigned char> carried(stride);
+	std::vector<unsigned char> swapped(stride);
+
+	for(size_t i = 0; i < numVerts; i++)
+	{
+		if( bMoved[i] || (remapTable[i] == REMAP_UNUSED) )
+			continue;
+
+		std::memcpy(carried.data(), data + i * stride, stride);
+		bMoved[i] = true;
+
+		size_t dest = remapTable[i];
+		while( !bMoved[dest] && (remapTable[dest] != REMAP_UNUSED) )
+		{
+			std::memcpy(swapped.data(), data + dest * stride, stride);
+			std::memcpy(data + dest * stride, carried.data(), stride);
+			std::swap(carried, swapped);
+
+			bMoved[dest] = true;
+			dest = remapTable[dest];
+		}
+
+		std::memcpy(data + dest * stride, carried.data(), stride);
+	}
+
+	return numUsed;
 }
 
 }  // namespace nv::tristrip
@@ -1,7 +1,11 @@
 #ifndef NV_TRISTRIP_H
 #define NV_TRISTRIP_H
 
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////////////
 // Public interface for stripifier
@@ -22,6 +26,15 @@ enum class PrimType
 	PT_FAN
 };
 
+//how lists are ordered when only lists are generated, see StripifyOptions
+enum class ListOptimizer
+{
+	LO_STRIPS,   // build strips and flatten them
+	LO_TIPSIFY   // skip the strips, and reorder the triangles directly, much faster
+};
+
+// A group owns its indices, and delete[]s them when it goes.  It can't be copied, which
+//  would free them twice, but it can be moved, which leaves the group moved from empty.
 struct PrimitiveGroup
 {
 	PrimType type;
@@ -36,8 +49,394 @@ struct PrimitiveGroup
 		delete[] indices;
 		indices = nullptr;
 	}
+
+	PrimitiveGroup(const PrimitiveGroup&) = delete;
+	PrimitiveGroup& operator=(const PrimitiveGroup&) = delete;
+
+	PrimitiveGroup(PrimitiveGroup&& other) noexcept : type(other.type), numIndices(other.numIndices), indices(other.indices)
+	{
+		other.numIndices = 0;
+		other.indices = nullptr;
+	}
+
+	PrimitiveGroup& operator=(PrimitiveGroup&& other) noexcept
+	{
+		if(this != &other)
+		{
+			delete[] indices;
+			type = other.type;
+			numIndices = other.numIndices;
+			indices = other.indices;
+			other.numIndices = 0;
+			other.indices = nullptr;
+		}
+		return *this;
+	}
+};
+
+struct StripifyProfile;
+
+////////////////////////////////////////////////////////////////////////////////////////
+// HardwareProfile
+//
+// What drawing costs on the GPU a mesh is stripified for, so the stripifier can weigh the
+//  strips it could build by that instead of only going for the longest ones.
+// The costs are in the time it takes to transform a vertex which missed the cache, only
+//  how they compare to each other matters.  The defaults are a starting point, time the
+//  target to get its own.
+// With a profile set in StripifyOptions, the cache of the profile is optimized for instead
+//  of cacheSize and bLRUCache, the profile picks which experiment of each round is kept,
+//  and how long the pieces the strips are cut into for the cache are.
+//
+struct HardwareProfile
+{
+	unsigned int cacheSize;  // vertices in the post transform cache
+	bool bLRUCache;          // the cache throws out the least recently used vertex, not the oldest
+
+	float vertexCost;        // a vertex transformed because it wasn't in the cache
+	float degenerateCost;    // an index which only makes degenerate triangles, stitching or turning a strip
+	float restartCost;       // a primitive restart index, with bRestartStrips
+	float drawCallCost;      // drawing a strip on its own, when strips are neither stitched nor restarted
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	HardwareProfile() : cacheSize(CACHESIZE_GEFORCE1_2), bLRUCache(false),
+		vertexCost(1.0f), degenerateCost(0.25f), restartCost(0.25f), drawCallCost(50.0f) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyProgress
+//
+// How far along a GenerateStrips() call is, see progressCallback in StripifyOptions.
+//  done counts up to total in the units of the phase, which can be 0 when there is
+//  nothing to count.
+//
+enum class StripifyPhase
+{
+	SP_BUILD_STRIPIFY_INFO,  // finding the edges and faces, total is the triangles
+	SP_FIND_ALL_STRIPS,      // faces committed to strips so far, out of all of them
+	SP_SPLIT_UP_STRIPS,      // strips ordered for the cache so far, out of all of them
+	SP_CREATE_STRIPS,        // writing out the indices, total is the strips
+	SP_OPTIMIZE_LIST,        // ordering a list with LO_TIPSIFY, total is the triangles
+	SP_CHUNKS                // chunks done so far, for a mesh cut into chunks
+};
+
+struct StripifyProgress
+{
+	StripifyPhase phase;
+	size_t done;
+	size_t total;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	StripifyProgress() : phase(StripifyPhase::SP_BUILD_STRIPIFY_INFO), done(0), total(0) {}
+	StripifyProgress(StripifyPhase in_phase, size_t in_done, size_t in_total) : phase(in_phase), done(in_done), total(in_total) {}
 };
 
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyOptions
+//
+// Everything the stripifier needs to know about how to process a mesh.
+// The GenerateStrips() overload taking one of these reads only the options handed to it,
+//  so separate threads can stripify separate meshes at the same time, each with its
+//  own options.
+// The Set*() functions below modify a single default set of options used by the
+//  original GenerateStrips(), and so are not thread safe.
+//
+struct StripifyOptions
+{
+	unsigned int cacheSize;    // see SetCacheSize()
+	bool bStitchStrips;        // see SetStitchStrips()
+	unsigned int minStripSize; // see SetMinStripSize()
+	bool bListsOnly;           // see SetListsOnly()
+	unsigned int numThreads;   // threads to stripify with, 0 means one per hardware thread, 1 stays on
+	                           //  the calling thread.  GenerateStrips() only starts threads for big meshes
+
+	// How hard to look for long strips.  Each round the stripifier tries building strips from
+	//  numSamples different faces, 6 ways each, and keeps the best.  Fewer samples is faster but
+	//  gives worse strips, a preview build might get away with 2.
+	// Once the experiments have built workBudget triangles in total (0 is no limit), the rest
+	//  of the mesh is done with a single sample per round.
+	// With bStopAtFullCover, a round stops at the first experiment which covers every face
+	//  left, instead of looking for a better one.
+	unsigned int numSamples;
+	size_t workBudget;
+	bool bStopAtFullCover;
+
+	// Optimize for a vertex cache which throws out the least recently used vertex, instead of
+	//  the one which went in first like the GeForce caches do.
+	bool bLRUCache;
+
+	// With bListsOnly, how to order the list.  LO_TIPSIFY goes straight for the vertex cache
+	//  in linear time, for a cache of cacheSize vertices, instead of going through the strips.
+	ListOptimizer listOptimizer;
+
+	bool bRestartStrips;       // see SetRestartStrips()
+
+	// For meshes too big to stripify in one go: above chunkSize triangles (0 is no limit) the
+	//  mesh is cut into runs of chunkSize triangles, in the order they come in, which are
+	//  stripified on their own, each with only the vertices it uses, and joined back up into
+	//  the same groups as usual.  Copies of a face are dropped from the whole mesh before it
+	//  is cut up, so they don't come out again from another chunk.  The stripifier only ever holds the chunks being worked on,
+	//  one per thread, but strips and the vertex cache don't carry over from one chunk to the
+	//  next, so the chunks should be compact pieces of the mesh, see SortTrianglesSpatially().
+	// The triangles left out of the strips of all the chunks are reordered for the cache
+	//  together, so the ones on either side of a chunk boundary can share vertices.
+	size_t chunkSize;
+
+	// Directory to keep every result in, and look for it next time, or nullptr for none.
+	//  A mesh which was stripified before with the same options, the number of threads and
+	//  the callbacks aside, is read back from its file instead, without running the
+	//  stripifier at all.  The directory has to exist; results are strip files named after
+	//  the hash of the mesh and options, and are never removed, see GenerateStripsFile()
+	//  for the layout.  Several threads and processes may share one directory.
+	const char* cacheDirectory;
+
+	// Called with a StripifyProfile of the stripifier at the end of each GenerateStrips() which
+	//  ran it, i.e. all but the LO_TIPSIFY ones, on the thread which called GenerateStrips() or
+	//  ran the mesh for GenerateStripsBatch().  A mesh cut into chunks calls it once for each
+	//  chunk, on the thread which ran the chunk, and one found in the cacheDirectory not at all.
+	//  Only a library built with NV_NVTS_ENABLE_PROFILING ever calls it.
+	void (*profileCallback)(const StripifyProfile& profile, void* userData);
+	void* profileUserData;
+
+	// Called with how far along the stripifier is, at the start of each phase, of each
+	//  experiment and of every few hundred strips ordered, from the thread which called
+	//  GenerateStrips() or whichever runs the experiment, one at a time for each mesh.  The
+	//  meshes of GenerateStripsBatch() report at the same time as each other.  A mesh cut
+	//  into chunks only reports the chunks as they are done.
+	// Returning false cancels the call: it stops at the next of those points, and hands
+	//  back an empty result, with Cancelled() set in a StripifyResult, which isn't stored in
+	//  the cacheDirectory.  The IncrementalStripifier doesn't report.
+	bool (*progressCallback)(const StripifyProgress& progress, void* userData);
+	void* progressUserData;
+
+	// The GPU to tune the output for, see HardwareProfile, or nullptr to go for the longest
+	//  strips with a cache of cacheSize as always.  It has to stay alive while it is used.
+	const HardwareProfile* hardwareProfile;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	StripifyOptions() : cacheSize(CACHESIZE_GEFORCE1_2), bStitchStrips(true), minStripSize(0), bListsOnly(false),
+		numThreads(0), numSamples(10), workBudget(0), bStopAtFullCover(false),
+		bLRUCache(false), listOptimizer(ListOptimizer::LO_STRIPS), bRestartStrips(false),
+		chunkSize(0), cacheDirectory(nullptr), profileCallback(nullptr), profileUserData(nullptr),
+		progressCallback(nullptr), progressUserData(nullptr), hardwareProfile(nullptr) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyBatchMesh
+//
+// One mesh handed to GenerateStripsBatch().
+// indices/numIndices are the input, primGroups/numGroups are filled in exactly like the
+//  outputs of GenerateStrips(), so be sure to call delete[] on primGroups when done.
+//
+struct StripifyBatchMesh
+{
+	const unsigned int* indices;
+	size_t numIndices;
+	PrimitiveGroup* primGroups;
+	size_t numGroups;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	StripifyBatchMesh() : indices(nullptr), numIndices(0), primGroups(nullptr), numGroups(0) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyTimings
+//
+// How long GenerateStrips() took, in seconds, in total and in each phase of the
+//  stripifier.  The lists only LO_TIPSIFY path has no phases, only a total.
+//
+struct StripifyTimings
+{
+	double buildStripifyInfo;         // finding the faces and edges of the mesh
+	double findAllStrips;             // the strip experiments
+	double splitUpStripsAndOptimize;  // cutting the strips up and ordering them for the cache
+	double createStrips;              // turning the strips into indices
+	double total;                     // the whole call, output included
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	StripifyTimings() : buildStripifyInfo(0.0), findAllStrips(0.0), splitUpStripsAndOptimize(0.0),
+		createStrips(0.0), total(0.0) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyProfile
+//
+// Where the stripifier spent its time and what it ran into on the way, for finding out
+//  why a mesh takes so long without attaching a profiler.  See profileCallback in
+//  StripifyOptions, this is only filled in by a library built with NV_NVTS_ENABLE_PROFILING.
+// The timers of the experiments, and of FindTraversal() and NvStripInfo::Build() which run
+//  inside them, are summed over all the threads that ran them, so they can add up to more
+//  than findAllStrips in StripifyTimings.
+//
+struct StripifyProfileTimer
+{
+	double seconds;
+	uint64_t calls;
+
+	StripifyProfileTimer() : seconds(0.0), calls(0) {}
+};
+
+struct StripifyProfile
+{
+	StripifyProfileTimer buildStripifyInfo;
+	StripifyProfileTimer findAllStripsSetup;        // phase 1, picking the faces to try
+	StripifyProfileTimer findAllStripsExperiments;  // phase 2, building strips from them
+	StripifyProfileTimer findAllStripsSelect;       // phase 3, picking the best experiment
+	StripifyProfileTimer findAllStripsCommit;       // phase 4, keeping it and dropping the rest
+	StripifyProfileTimer findTraversal;             // looking for where the next strip of an experiment starts
+	StripifyProfileTimer buildStrip;                // NvStripInfo::Build()
+	StripifyProfileTimer splitUpStripsAndOptimize;
+	StripifyProfileTimer removeSmallStrips;
+	StripifyProfileTimer createStrips;
+
+	uint64_t findAllStripsRounds;    // rounds of experiments
+	uint64_t experimentsBuilt;
+	uint64_t stripsBuilt;            // by the experiments, most are thrown away
+	uint64_t edgeLookups;            // finding the edge between two vertices
+	uint64_t edgeProbes;             // hash table slots looked at by those
+	uint64_t maxEdgeProbes;          //  and the most by any one of them
+	uint64_t traversalEdgeSteps;     // edges walked around vertices by FindTraversal()
+	uint64_t maxTraversalEdgeSteps;  //  and the most by any one call, high valence vertices show here
+	uint64_t cacheTests;             // vertices looked up in the simulated cache while ordering strips
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	StripifyProfile() : findAllStripsRounds(0), experimentsBuilt(0), stripsBuilt(0), edgeLookups(0),
+		edgeProbes(0), maxEdgeProbes(0), traversalEdgeSteps(0), maxTraversalEdgeSteps(0), cacheTests(0) {}
+};
+
+namespace internal { template<typename IndexT> struct StripifyResultWriter; }
+
+////////////////////////////////////////////////////////////////////////////////////////
+// BasicStripifyResult
+//
+// What the GenerateStrips() overloads taking 16 or 32 bit indices hand back: the same
+//  groups the other overloads make, but with the indices of all of them in one block of
+//  IndexT, uint16_t or uint32_t, instead of a new[] of size_t per group.
+// Indices() can go straight into an index buffer, or find out how much room they need
+//  with NumIndices() and have CopyIndices() write them into your own buffers.
+//
+template<typename IndexT>
+class BasicStripifyResult
+{
+public:
+	//the primitive restart index for this width, 0xFFFF or 0xFFFFFFFF
+	static constexpr IndexT RESTART_INDEX{static_cast<IndexT>(~IndexT{0})};
+
+	BasicStripifyResult() = default;
+	BasicStripifyResult(const BasicStripifyResult&) = default;
+	BasicStripifyResult& operator=(const BasicStripifyResult&) = default;
+
+	//moving hands over the indices without copying them, and leaves the result moved from
+	// empty, with no groups, as if just made
+	BasicStripifyResult(BasicStripifyResult&& other) noexcept
+		: types(std::move(other.types)), starts(std::move(other.starts)), indices(std::move(other.indices)),
+		  maxIndex(other.maxIndex), timings(other.timings), bCancelled(other.bCancelled)
+	{
+		other.Clear();
+	}
+
+	BasicStripifyResult& operator=(BasicStripifyResult&& other) noexcept
+	{
+		if(this != &other)
+		{
+			types    = std::move(other.types);
+			starts   = std::move(other.starts);
+			indices  = std::move(other.indices);
+			maxIndex = other.maxIndex;
+			timings  = other.timings;
+			bCancelled = other.bCancelled;
+			other.Clear();
+		}
+		return *this;
+	}
+
+	size_t NumGroups() const { return types.size(); }
+	PrimType GroupType(const size_t group) const { return types[group]; }
+
+	//where the group starts among the indices of all the groups, and how many it has
+	size_t GroupStart(const size_t group) const { return starts[group]; }
+	size_t NumIndices(const size_t group) const { return starts[group + 1] - starts[group]; }
+
+	//the indices of all the groups, each group starting at GroupStart()
+	const IndexT* Indices() const { return indices.data(); }
+	size_t NumIndices() const { return indices.size(); }
+
+	//biggest index in any of the groups, restart indices aside, they all fit in 16 bits if
+	// this is 0xFFFF or less
+	IndexT MaxIndex() const { return maxIndex; }
+
+	//how long the GenerateStrips() call which made this took
+	const StripifyTimings& Timings() const { return timings; }
+
+	//whether the progressCallback cancelled the GenerateStrips() call which made this, which
+	// leaves it without any groups
+	bool Cancelled() const { return bCancelled; }
+
+	//the restart index once copied out as OutIndexT, 0xFFFF for 16 bits, and 0xFFFFFFFF for
+	// anything wider, like the size_t indices of PrimitiveGroups
+	template<typename OutIndexT>
+	static constexpr OutIndexT OutRestartIndex()
+	{
+		return (sizeof(OutIndexT) < sizeof(uint32_t)) ? static_cast<OutIndexT>(~OutIndexT{0}) : static_cast<OutIndexT>(0xFFFFFFFFu);
+	}
+
+	//copies the indices of group into out, which needs room for NumIndices(group) of them.
+	// Restart indices come out as OutRestartIndex<OutIndexT>()
+	template<typename OutIndexT>
+	void CopyIndices(const size_t group, OutIndexT* out) const
+	{
+		assert(maxIndex <= static_cast<OutIndexT>(~OutIndexT{0}));
+
+		for(size_t i = starts[group]; i < starts[group + 1]; i++)
+			*out++ = CopyIndex<OutIndexT>(indices[i]);
+	}
+
+	//copies the indices of all the groups into out, which needs room for NumIndices()
+	template<typename OutIndexT>
+	void CopyIndices(OutIndexT* out) const
+	{
+		assert(maxIndex <= static_cast<OutIndexT>(~OutIndexT{0}));
+
+		for(auto index : indices)
+			*out++ = CopyIndex<OutIndexT>(index);
+	}
+
+	void Clear()
+	{
+		types.clear();
+		starts.assign(1, 0);
+		indices.clear();
+		maxIndex = 0;
+		timings = StripifyTimings();
+		bCancelled = false;
+	}
+
+private:
+	friend struct internal::StripifyResultWriter<IndexT>;
+
+	std::vector<PrimType> types;
+	std::vector<size_t>   starts = {0};  // one more than there are groups, the last is the end
+	std::vector<IndexT>   indices;
+	IndexT maxIndex = 0;
+	StripifyTimings timings;
+	bool bCancelled = false;
+
+	template<typename OutIndexT>
+	static OutIndexT CopyIndex(const IndexT index)
+	{
+		return (index == RESTART_INDEX) ? OutRestartIndex<OutIndexT>() : static_cast<OutIndexT>(index);
+	}
+};
+
+using StripifyResult   = BasicStripifyResult<uint32_t>;
+using StripifyResult16 = BasicStripifyResult<uint16_t>;
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // SetCacheSize()
 //
@@ -64,6 +463,20 @@ void SetCacheSize(const unsigned int cacheSize);
 void SetStitchStrips(const bool bStitchStrips);
 
 
+////////////////////////////////////////////////////////////////////////////////////////
+// SetRestartStrips()
+//
+// bool to indicate whether to join strips with primitive restart indices instead.
+// If set to true, you'll get back one strip, with the restart index between the separate
+//  strips, and SetStitchStrips() has no effect.  Draw it with primitive restart enabled
+//  for that index: the RESTART_INDEX of the StripifyResult, or 0xFFFFFFFF in
+//  PrimitiveGroups.  No vertex may use that index.
+//
+// Default value: false
+//
+void SetRestartStrips(const bool bRestartStrips);
+
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // SetMinStripSize()
 //
@@ -93,12 +506,467 @@ void SetListsOnly(const bool bListsOnly);
 // primGroups: array of optimized/stripified PrimitiveGroups
 // numGroups: number of groups returned
 //
-// Be sure to call delete[] on the returned primGroups to avoid leaking mem
+// Be sure to call delete[] on the returned primGroups to avoid leaking mem.  Each group
+//  has its indices in a new[] of their own, the overloads taking a StripifyResult keep
+//  those of all the groups in one block instead, which can be moved around without copying.
 //
 void GenerateStrips(const unsigned int* in_indices, const size_t in_numIndices,
 					PrimitiveGroup** primGroups, size_t* numGroups);
 
 
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStrips()
+//
+// Same as above, but uses the given options instead of the ones set through Set*().
+// This version does not touch any shared state, and thus may be called from several
+//  threads at once.
+// Big meshes are stripified using options.numThreads threads, the result is the same
+//  no matter how many there are.
+//
+// options: settings to stripify with
+// in_indices: input index list, the indices you would use to render
+// in_numIndices: number of entries in in_indices
+// primGroups: array of optimized/stripified PrimitiveGroups
+// numGroups: number of groups returned
+//
+// Be sure to call delete[] on the returned primGroups to avoid leaking mem
+//
+void GenerateStrips(const StripifyOptions& options,
+					const unsigned int* in_indices, const size_t in_numIndices,
+					PrimitiveGroup** primGroups, size_t* numGroups);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStrips()
+//
+// Same again, but reads 16 or 32 bit indices right where they are, without copying them,
+//  and leaves the output in a StripifyResult or StripifyResult16.  16 bit meshes can stay
+//  16 bit all the way through.
+// Separate strips (SetStitchStrips(false)) are told apart internally by the restart index
+//  of the output width, so no vertex may have that index then.
+//
+// options: settings to stripify with
+// in_indices: input index list, the indices you would use to render
+// in_numIndices: number of entries in in_indices
+// result: filled in with the optimized/stripified groups, anything in it before is lost
+//
+void GenerateStrips(const StripifyOptions& options,
+					const uint16_t* in_indices, const size_t in_numIndices,
+					StripifyResult16& result);
+void GenerateStrips(const StripifyOptions& options,
+					const uint16_t* in_indices, const size_t in_numIndices,
+					StripifyResult& result);
+void GenerateStrips(const StripifyOptions& options,
+					const uint32_t* in_indices, const size_t in_numIndices,
+					StripifyResult& result);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GetLastStripifyTimings()
+//
+// How long the last GenerateStrips() call made on this thread took, whichever overload
+//  it was.  The threads of GenerateStripsBatch() don't count, the calling thread keeps
+//  whatever it had before.
+//
+void GetLastStripifyTimings(StripifyTimings* timings);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsBatch()
+//
+// Stripifies a whole bunch of meshes at once, spread over options.numThreads threads.
+// The calling thread helps out, and returns once every mesh is done.
+// Big meshes are started first, and threads which run out of work steal it from the
+//  others, so a few huge meshes in a sea of small ones don't leave cores idle at the end.
+//
+// options: settings to stripify every mesh with
+// meshes: array of meshes, see StripifyBatchMesh
+// numMeshes: number of entries in meshes
+//
+void GenerateStripsBatch(const StripifyOptions& options,
+						 StripifyBatchMesh* meshes, const size_t numMeshes);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Index and strip files
+//
+// What GenerateStripsFile() reads and writes.  Everything is in the byte order of the
+//  machine which wrote it, a header from a machine of the other order doesn't have the
+//  right magic.
+//
+// An index file is either nothing but indices, 16 or 32 bit, or an IndexFileHeader
+//  followed by the numIndices indices it says, indexSize bytes each.
+//
+// A strip file is a StripFileHeader, then numGroups StripFileGroups, then the indices of
+//  all the groups one after the other, indexSize bytes each, just like the Indices() of
+//  a StripifyResult, restart indices and all.  They start 8 byte aligned, so a strip
+//  file mapped into memory can go to an index buffer in place.
+//
+enum class IndexFileFormat
+{
+	IFF_HEADER,  // starts with an IndexFileHeader
+	IFF_RAW16,   // nothing but 16 bit indices
+	IFF_RAW32    // nothing but 32 bit indices
+};
+
+constexpr inline uint32_t INDEX_FILE_MAGIC{0x4954564E};  // "NVTI"
+constexpr inline uint32_t STRIP_FILE_MAGIC{0x5354564E};  // "NVTS"
+constexpr inline uint32_t INDEX_FILE_VERSION{1};
+constexpr inline uint32_t STRIP_FILE_VERSION{1};
+
+struct IndexFileHeader
+{
+	uint32_t magic;       // INDEX_FILE_MAGIC
+	uint32_t version;     // INDEX_FILE_VERSION
+	uint32_t indexSize;   // 2 or 4
+	uint32_t reserved;    // 0
+	uint64_t numIndices;
+};
+
+struct StripFileHeader
+{
+	uint32_t magic;       // STRIP_FILE_MAGIC
+	uint32_t version;     // STRIP_FILE_VERSION
+	uint32_t indexSize;   // 2 or 4, the same as the index file
+	uint32_t numGroups;
+	uint64_t numIndices;  // in all the groups
+};
+
+struct StripFileGroup
+{
+	uint32_t type;        // PrimType, 0 for PT_LIST, 1 for PT_STRIP, 2 for PT_FAN
+	uint32_t reserved;    // 0
+	uint64_t numIndices;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsFile()
+//
+// Stripifies the mesh in an index file into a strip file, see above.  The index file is
+//  mapped into memory and stripified right where it is, and the strip file is written
+//  straight from the one block of indices a StripifyResult holds, so the indices are
+//  never copied on the way, and never go through size_t.  16 bit indices stay 16 bit.
+//
+// options: settings to stripify with
+// in_fileName: index file to read
+// in_format: what it looks like
+// out_fileName: strip file to write, anything there is overwritten
+//
+// Returns false, leaving no strip file behind, if the index file can't be read or isn't
+//  what in_format says, a vertex has the restart index while the strips are neither
+//  stitched nor lists, the progressCallback of options cancels, or the strip file can't
+//  be written
+//
+bool GenerateStripsFile(const StripifyOptions& options,
+						const char* in_fileName, const IndexFileFormat in_format,
+						const char* out_fileName);
+
+
+namespace internal { class NvIncrementalStripifier; }
+
+////////////////////////////////////////////////////////////////////////////////////////
+// IncrementalStripifier
+//
+// Keeps a mesh and its strips around between calls, for meshes which change a little at
+//  a time, like in an editor.  After deleting a few faces or welding a seam, Update()
+//  builds only the strips which held a removed triangle, or ran next to an added one,
+//  again, and slots them in where the old ones were in the cache order, so the result
+//  comes back in a fraction of the time a whole GenerateStrips() takes.
+// The first Update() after SetMesh() stripifies the whole mesh, exactly like
+//  GenerateStrips() with the same options.  The edits after that give strips which are
+//  just as good locally, but the mesh as a whole drifts away from what GenerateStrips()
+//  would make of it, so call SetMesh() again now and then to start over.
+// chunkSize and cacheDirectory are not used; with LO_TIPSIFY lists there are no strips
+//  to keep, and each Update() orders the whole list again, which is quick anyway.
+// Not thread safe, but separate IncrementalStripifiers can be used by separate threads.
+//
+class IncrementalStripifier
+{
+public:
+	IncrementalStripifier();
+	~IncrementalStripifier();
+
+	IncrementalStripifier(const IncrementalStripifier&) = delete;
+	IncrementalStripifier& operator=(const IncrementalStripifier&) = delete;
+
+	// Throws away the mesh, and starts again with the triangles of in_indices, numbered
+	//  from 0 in order, to be stripified with options from now on.
+	void SetMesh(const StripifyOptions& options, const uint32_t* in_indices, const size_t in_numIndices);
+
+	// Adds the triangles of in_indices to the mesh, numbered on from the last triangle added,
+	//  and returns the number of the first one.  Triangles keep their number until removed.
+	size_t AddTriangles(const uint32_t* in_indices, const size_t in_numIndices);
+
+	// Takes triangles out of the mesh, by number.  Returns false, removing none of them, if
+	//  any was removed before, or never added.
+	bool RemoveTriangles(const size_t* triangles, const size_t numTriangles);
+
+	// Brings the strips up to date with the edits since the last call, and fills result in
+	//  with the groups for the whole mesh, like GenerateStrips() does.  buildStripifyInfo
+	//  in its timings is how long the edits took.
+	void Update(StripifyResult& result);
+
+	// Triangles in the mesh, not counting the removed ones
+	size_t NumTriangles() const;
+
+private:
+	StripifyOptions options;
+	internal::NvIncrementalStripifier* stripifier;
+};
+
+
+namespace internal { struct StripifyTaskState; }
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyTask
+//
+// A GenerateStrips() call running on a thread of its own, see GenerateStripsAsync(), which
+//  can be watched and cancelled from any thread while it goes.
+// A task runs one call at a time, and can be used for another once it is done.  The
+//  thread which started the call can do anything with the task, other threads only call
+//  Cancel(), IsDone(), Progress() and Cancelled().
+//
+class StripifyTask
+{
+public:
+	StripifyTask();
+
+	// Cancels the call, if it is still running, and waits for it
+	~StripifyTask();
+
+	StripifyTask(const StripifyTask&) = delete;
+	StripifyTask& operator=(const StripifyTask&) = delete;
+
+	// Asks the call to stop, at the next point it reports its progress at
+	void Cancel();
+
+	// Whether the call has finished, or there never was one
+	bool IsDone() const;
+
+	// Returns once the call has finished
+	void Wait();
+
+	// How far along the call was when it last reported
+	StripifyProgress Progress() const;
+
+	// Whether the call was cancelled, by Cancel() or the progressCallback of its options
+	bool Cancelled() const;
+
+	// What the call made, once Wait() returns, with Cancelled() set if it was cancelled
+	StripifyResult& Result();
+
+private:
+	friend void GenerateStripsAsync(const StripifyOptions& options,
+									const uint32_t* in_indices, const size_t in_numIndices,
+									StripifyTask& task);
+
+	internal::StripifyTaskState* state;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateStripsAsync()
+//
+// Starts GenerateStrips() on a thread of its own and returns right away, see StripifyTask.
+//  If the task is still running a call, that one is cancelled and waited for first.
+//  The progressCallback of options still gets called, on the thread of the task.
+//
+// options: settings to stripify with, copied, though a hardwareProfile has to stay alive
+// in_indices: input index list, the indices you would use to render, which have to stay
+//  alive, and unchanged, until the task is done
+// in_numIndices: number of entries in in_indices
+// task: where the call runs, and its result ends up
+//
+void GenerateStripsAsync(const StripifyOptions& options,
+						 const uint32_t* in_indices, const size_t in_numIndices,
+						 StripifyTask& task);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// StripifyStats
+//
+// How well a set of groups should draw, see CalcStripifyStats().
+//
+struct StripifyStats
+{
+	size_t numIndices;      // all the indices, restart indices included
+	size_t numTriangles;    // triangles drawn, not counting degenerates
+	size_t numDegenerates;  // degenerate triangles, in strips and lists
+	size_t numStrips;       // separate strips, each restart index starts a new one
+	size_t numVertices;     // different vertices used
+	size_t numCacheMisses;  // vertices transformed, going through the cache
+	float acmr;             // average cache miss ratio, misses per triangle
+	float atvr;             // average transform to vertex ratio, misses per vertex used, 1 at best
+	float avgStripLength;   // triangles per strip, not counting degenerates
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	StripifyStats() : numIndices(0), numTriangles(0), numDegenerates(0), numStrips(0), numVertices(0),
+		numCacheMisses(0), acmr(0.0f), atvr(0.0f), avgStripLength(0.0f) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// CalcStripifyStats()
+//
+// Draws groups through a simulated post TnL cache and reports what it sees.  The groups
+//  are drawn in order with the cache carried across them, and strips are split at the
+//  restart index, 0xFFFFFFFF in PrimitiveGroups, whether or not they were made with
+//  SetRestartStrips().
+//
+// primGroups/result: the groups to measure
+// numGroups: number of entries in primGroups
+// cacheSize: number of vertices in the cache, i.e. 16 on GeForce1/2, 24 on GeForce3
+// bLRUCache: the cache throws out the least recently used vertex instead of the oldest
+// stats: filled in with the results
+//
+void CalcStripifyStats(const PrimitiveGroup* primGroups, const size_t numGroups,
+					   const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats);
+void CalcStripifyStats(const StripifyResult16& result,
+					   const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats);
+void CalcStripifyStats(const StripifyResult& result,
+					   const unsigned int cacheSize, const bool bLRUCache, StripifyStats* stats);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// ReduceOverdraw()
+//
+// Reorders the triangles of the lists in primGroups, in place, so that fewer pixels get
+//  drawn over from most viewpoints, without giving up much of the vertex cache order
+//  GenerateStrips() came up with.  Run it on lists only output, strips and fans are
+//  left alone.
+// Each list is cut into runs of triangles, just long enough that starting a run with an
+//  empty cache doesn't cost much, and the runs facing out of the mesh are moved first.
+//  If the average cache misses per triangle would go up more than maxACMRRatio times,
+//  the list is kept as it was, and so is a list with an index past numVerts.
+//
+// options: settings the groups were generated with, for the cache size and policy
+// primGroups: array of PrimitiveGroups to reorder
+// numGroups: number of entries in primGroups
+// positions: x, y, z of the first vertex, each vertex positionStride bytes after the last
+// numVerts: number of vertices in positions
+// maxACMRRatio: how much worse the cache may do, 1.05 is 5% more misses
+//
+// Returns true if any of the lists was reordered
+//
+bool ReduceOverdraw(const StripifyOptions& options,
+					PrimitiveGroup* primGroups, const size_t numGroups,
+					const float* positions, const size_t positionStride, const size_t numVerts,
+					const float maxACMRRatio = 1.05f);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// SortTrianglesSpatially()
+//
+// Reorders the triangles of a list, in place, so that triangles close together in space
+//  end up close together in the list, along a Morton curve through their middles.  Run
+//  it on a huge mesh before GenerateStrips() with a chunkSize, so every chunk is one
+//  compact piece of the mesh, with few vertices and little boundary.  The triangles keep
+//  their winding, but the vertex cache order of the list is lost.
+//
+// in_indices: index list to reorder
+// in_numIndices: number of entries in in_indices
+// positions: x, y, z of the first vertex, each vertex positionStride bytes after the last
+// numVerts: number of vertices in positions
+//
+// Returns false, leaving the list as it was, if an index is past numVerts
+//
+bool SortTrianglesSpatially(uint16_t* in_indices, const size_t in_numIndices,
+							const float* positions, const size_t positionStride, const size_t numVerts);
+bool SortTrianglesSpatially(uint32_t* in_indices, const size_t in_numIndices,
+							const float* positions, const size_t positionStride, const size_t numVerts);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// MeshletOptions
+//
+// How big the meshlets of GenerateMeshlets() may get.  The defaults fit the usual mesh
+//  shader limits, maxVertices may be at most 256 so the local indices fit in a byte.
+//
+struct MeshletOptions
+{
+	unsigned int maxVertices;
+	unsigned int maxTriangles;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	MeshletOptions() : maxVertices(64), maxTriangles(124) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Meshlet
+//
+// A small piece of the mesh, with a vertex list of its own and triangles indexing into
+//  that, and bounds for culling it as a whole.
+//
+struct Meshlet
+{
+	uint32_t vertexOffset;    // its vertices start at MeshletResult::vertices[vertexOffset]
+	uint32_t vertexCount;
+	uint32_t triangleOffset;  // its local indices start at MeshletResult::triangles[triangleOffset * 3]
+	uint32_t triangleCount;
+
+	// Sphere around all of its vertices
+	float center[3];
+	float radius;
+
+	// All its triangle normals are within acos(coneCutoff) of coneAxis.  If coneCutoff is
+	//  above 0, the whole meshlet faces away from a view direction d, a unit vector
+	//  pointing into the scene, when dot(d, coneAxis) > sqrt(1 - coneCutoff * coneCutoff).
+	float coneAxis[3];
+	float coneCutoff;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// MeshletResult
+//
+// What GenerateMeshlets() hands back.  vertices holds the original index of each vertex
+//  of each meshlet, triangles three local indices per triangle, into the vertices of
+//  the meshlet, wound like the input.  Both are in meshlet order.
+//
+struct MeshletResult
+{
+	std::vector<Meshlet> meshlets;
+	std::vector<uint32_t> vertices;
+	std::vector<uint8_t> triangles;
+
+////////////////////////////////////////////////////////////////////////////////////////
+
+	void Clear()
+	{
+		meshlets.clear();
+		vertices.clear();
+		triangles.clear();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// GenerateMeshlets()
+//
+// Cuts a triangle list up into meshlets for mesh shaders and GPU culling, on the same
+//  face and edge adjacency the stripifier builds.  Each meshlet starts where the last one
+//  left off and grows over the triangles sharing the most vertices with it, which keeps
+//  meshlets compact, so their bounds are tight.  Degenerate and duplicate triangles are
+//  dropped, like GenerateStrips() does.
+//
+// options: how big the meshlets may get
+// in_indices: input index list, the indices you would use to render
+// in_numIndices: number of entries in in_indices
+// positions: x, y, z of the first vertex, each vertex positionStride bytes after the last,
+//  or nullptr to leave the bounds at 0
+// numVerts: number of vertices in positions
+// result: filled in with the meshlets, anything in it before is thrown away
+//
+// Returns false if the options are out of range, or an index is past numVerts
+//
+bool GenerateMeshlets(const MeshletOptions& options,
+					  const uint16_t* in_indices, const size_t in_numIndices,
+					  const float* positions, const size_t positionStride, const size_t numVerts,
+					  MeshletResult& result);
+bool GenerateMeshlets(const MeshletOptions& options,
+					  const uint32_t* in_indices, const size_t in_numIndices,
+					  const float* positions, const size_t positionStride, const size_t numVerts,
+					  MeshletResult& result);
+
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // RemapIndices()
 //
@@ -112,12 +980,51 @@ void GenerateStrips(const unsigned int* in_indices, const size_t in_numIndices,
 //
 // Note that, according to the remapping handed back to you, you must reorder your 
 //  vertex buffer.
+// Strips made with SetRestartStrips() are fine: their restart indices, 0xFFFFFFFF,
+//  are handed back as they are, and don't count as a vertex.
 //
 // Credit goes to the MS Xbox crew for the idea for this interface.
 //
 void RemapIndices(const PrimitiveGroup* in_primGroups, const size_t numGroups, 
 				  const size_t numVerts, PrimitiveGroup** remappedGroups);
 
+
+//remap table entry of a vertex which isn't used
+constexpr inline size_t REMAP_UNUSED{~size_t{0}};
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RemapIndices()
+//
+// Same as above, but also hands back the remapping, for use with RemapVertices().
+//
+// remapTable: array of numVerts entries to fill in, remapTable[oldIndex] is the new index
+//  of that vertex, or REMAP_UNUSED if none of the groups use it
+//
+// Returns the number of vertices used, the new indices run from 0 up to that
+//
+size_t RemapIndices(const PrimitiveGroup* in_primGroups, const size_t numGroups,
+					const size_t numVerts, PrimitiveGroup** remappedGroups, size_t* remapTable);
+
+
+////////////////////////////////////////////////////////////////////////////////////////
+// RemapVertices()
+//
+// Reorders a vertex buffer to go with the indices from RemapIndices(), dropping the
+//  vertices marked REMAP_UNUSED.
+//
+// vertices: the vertex buffer, vertex i starts i * stride bytes in
+// stride: size of each vertex in bytes, everything in those bytes moves along with it
+// numVerts: number of vertices in vertices, and entries in remapTable
+// remapTable: old index --> new index, as filled in by RemapIndices()
+// out_vertices: buffer to write the reordered vertices into, with room for all the ones
+//  used, or nullptr to reorder vertices in place.  Vertices past the ones used are
+//  left with whatever is there after that.
+//
+// Returns the number of vertices used
+//
+size_t RemapVertices(void* vertices, const size_t stride, const size_t numVerts,
+					 const size_t* remapTable, void* out_vertices = nullptr);
+
 }  // namespace nv::tristrip
 
 #endif
@@ -1,13 +1,19 @@
 #include "NvTriStripObjects.h"
 
+#include "Profiler.h"
+#include "StripOrderQueue.h"
+#include "ThreadPool.h"
 #include "VertexCache.h"
 
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -16,44 +22,81 @@ namespace nv::tristrip::internal {
 
 constexpr inline int CACHE_INEFFICIENCY{6};
 
+//strips SplitUpStripsAndOptimize() orders between progress reports
+constexpr inline size_t PROGRESS_STRIPS{256};
+
+//seconds gone by since start, for the phase times
+static double SecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
 NvStripifier::NvStripifier()
 {
   cacheSize = 0;
   minStripLength = 0;
   meshJump = 0;
   bFirstTimeResetPoint = false;
+  threadPool = nullptr;
+  resetFaces = nullptr;
+  bRestartStrips = false;
+  numSamples = 10;
+  workBudget = 0;
+  bStopAtFullCover = false;
+  cachePolicy = CachePolicy::FIFO;
+  costId = 0;
+  progressCallback = nullptr;
+  progressUserData = nullptr;
+  bCancelled = false;
 }
 
 NvStripifier::~NvStripifier() = default;
 
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// StripCostsFor()
+//
+// Joining a strip to the one before costs the two indices of a stitch, a restart index, or
+//  a draw call of its own, and nothing when the strips end up in a list, which leaves the
+//  degenerates out too
+//
+NvStripCosts StripCostsFor(const StripifyOptions& options)
+{
+	NvStripCosts result;
+
+	const HardwareProfile* profile = options.hardwareProfile;
+	if(profile == nullptr)
+		return result;
+
+	result.bEnabled   = true;
+	result.vertexCost = profile->vertexCost;
+
+	if(!options.bListsOnly)
+	{
+		result.degenerateCost = profile->degenerateCost;
+
+		if(options.bRestartStrips)
+			result.joinCost = profile->restartCost;
+		else if(options.bStitchStrips)
+			result.joinCost = 2.0f * profile->degenerateCost;
+		else
+			result.joinCost = profile->drawCallCost;
+	}
+
+	return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // FindEdgeInfo()
 //
 // find the edge info for these two indices
 //
-NvEdgeInfo * NvStripifier::FindEdgeInfo(const NvEdgeInfoVec &edgeInfos, int v0, int v1){
+NvEdgeInfo * NvStripifier::FindEdgeInfo(NvMeshInfo &meshInfo, int v0, int v1){
 	
-	// we can get to it through either array
-	// because the edge infos have a v0 and v1
-	// and there is no order except how it was
-	// first created.
-	NvEdgeInfo *infoIter = edgeInfos[v0];
-	while (infoIter != nullptr){
-		if (infoIter->m_v0 == v0){
-			if (infoIter->m_v1 == v1)
-				return infoIter;
-
-			infoIter = infoIter->m_nextV0;
-		}
-		else {
-			assert(infoIter->m_v1 == v0);
-			if (infoIter->m_v0 == v1)
-				return infoIter;
-
-			infoIter = infoIter->m_nextV1;
-		}
-	}
-	return nullptr;
+	// the mesh hashes on the (min, max) vertex pair, because
+	// the edge infos have a v0 and v1 and there is no order
+	// except how it was first created.
+	return meshInfo.FindEdge(v0, v1);
 }
 
 
@@ -63,8 +106,8 @@ NvEdgeInfo * NvStripifier::FindEdgeInfo(const NvEdgeInfoVec &edgeInfos, int v0,
 // find the other face sharing these vertices
 // exactly like the edge info above
 //
-NvFaceInfo * NvStripifier::FindOtherFace(NvEdgeInfoVec &edgeInfos, int v0, int v1, const NvFaceInfo *faceInfo){
-	NvEdgeInfo *edgeInfo = FindEdgeInfo(edgeInfos, v0, v1);
+NvFaceInfo * NvStripifier::FindOtherFace(NvMeshInfo &meshInfo, int v0, int v1, const NvFaceInfo *faceInfo){
+	NvEdgeInfo *edgeInfo = FindEdgeInfo(meshInfo, v0, v1);
 
 	if( (edgeInfo == nullptr) && (v0 == v1))
 	{
@@ -73,20 +116,31 @@ NvFaceInfo * NvStripifier::FindOtherFace(NvEdgeInfoVec &edgeInfos, int v0, int v
 	}
 
 	assert(edgeInfo != nullptr);
-	return (edgeInfo->m_face0 == faceInfo ? edgeInfo->m_face1 : edgeInfo->m_face0);
+	return meshInfo.Face(edgeInfo->m_face0 == faceInfo->m_index ? edgeInfo->m_face1 : edgeInfo->m_face0);
 }
 
 
-bool NvStripifier::AlreadyExists(NvFaceInfo* faceInfo, const NvFaceInfoVec& faceInfos)
+///////////////////////////////////////////////////////////////////////////////////////////
+// AlreadyExists()
+//
+// Returns true if another face in the mesh is exactly this one
+//
+// A copy of the face has the same v0-v1 edge, so it is one of the two faces on that edge,
+//  unless the edge already had two when it came, and then the mesh remembers it as an
+//  off edge face.  Either way we never have to look through all the faces.
+//
+bool NvStripifier::AlreadyExists(NvFaceInfo* faceInfo, NvMeshInfo& meshInfo, const NvEdgeInfo* edgeInfo01)
 {
-	return std::any_of(std::begin(faceInfos),
-		std::end(faceInfos),
-		[faceInfo](const NvFaceInfo* f) noexcept {
-			return
-				(f->m_v0 == faceInfo->m_v0) &&
-				(f->m_v1 == faceInfo->m_v1) &&
-				(f->m_v2 == faceInfo->m_v2);
-		});
+	auto isCopy = [faceInfo](const NvFaceInfo *f) {
+		return (f != nullptr) && (f != faceInfo) &&
+			   (f->m_v0 == faceInfo->m_v0) &&
+			   (f->m_v1 == faceInfo->m_v1) &&
+			   (f->m_v2 == faceInfo->m_v2);
+	};
+
+	return isCopy(meshInfo.Face(edgeInfo01->m_face0)) ||
+		   isCopy(meshInfo.Face(edgeInfo01->m_face1)) ||
+		   meshInfo.IsOffEdgeFace(faceInfo->m_v0, faceInfo->m_v1, faceInfo->m_v2);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -94,17 +148,13 @@ bool NvStripifier::AlreadyExists(NvFaceInfo* faceInfo, const NvFaceInfoVec& face
 //
 // Builds the list of all face and edge infos
 //
-void NvStripifier::BuildStripifyInfo(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos,
-									 const size_t maxIndex)
+template<typename IndexT>
+void NvStripifier::BuildStripifyInfo(NvMeshInfo &meshInfo, const IndexT* indices, const size_t numIndices, const size_t maxIndex)
 {
-	// reserve space for the face infos, but do not resize them.
-	size_t numIndices = indices.size();
-	faceInfos.reserve(numIndices / 3);
-	
-	// we actually resize the edge infos, so we must initialize to nullptr
-	edgeInfos.resize(maxIndex + 1);
-	for (size_t i = 0; i < maxIndex + 1; i++)
-		edgeInfos[i] = nullptr;
+	NV_NVTS_PROFILE_TIMER(timer, buildStripifyInfo);
+
+	// make room for every vertex and face
+	meshInfo.Reset(maxIndex + 1, numIndices / 3);
 	
 	// iterate through the triangles of the triangle list
 	size_t numTriangles = numIndices / 3;
@@ -114,6 +164,7 @@ void NvStripifier::BuildStripifyInfo(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &ed
 	for (size_t i = 0; i < numTriangles; i++)
 	{
 		bool bMightAlreadyExist = true;
+		bool bOffEdge01 = false;
 		bFaceUpdated[0] = false;
 		bFaceUpdated[1] = false;
 		bFaceUpdated[2] = false;
@@ -127,126 +178,105 @@ void NvStripifier::BuildStripifyInfo(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &ed
 		if(IsDegenerate(v0, v1, v2))
 			continue;
 		
-		// create the face info and add it to the list of faces, but only if this exact face doesn't already 
-		//  exist in the list
-		NvFaceInfo *faceInfo = new NvFaceInfo(v0, v1, v2);
-
-		// grab the edge infos, creating them if they do not already exist
-		NvEdgeInfo *edgeInfo01 = FindEdgeInfo(edgeInfos, v0, v1);
-		if (edgeInfo01 == nullptr)
+		// add the face info to the list of faces, we take it back below if this exact face
+		//  already exists in the list
+		NvIndex faceIndex = meshInfo.AddFace(v0, v1, v2);
+
+		// grab the edge infos, creating them if they do not already exist.
+		// we hold on to them by index, adding edges may move them around
+		NvIndex edgeInfo01 = meshInfo.FindEdgeIndex(v0, v1);
+		if (edgeInfo01 == NV_INVALID_INDEX)
 		{
 			//since one of it's edges isn't in the edge data structure, it can't already exist in the face structure
 			bMightAlreadyExist = false;
 
-			// create the info
-			edgeInfo01 = new NvEdgeInfo(v0, v1);
-			
-			// update the linked list on both 
-			edgeInfo01->m_nextV0 = edgeInfos[v0];
-			edgeInfo01->m_nextV1 = edgeInfos[v1];
-			edgeInfos[v0] = edgeInfo01;
-			edgeInfos[v1] = edgeInfo01;
+			// create the info, this updates the linked list on both 
+			edgeInfo01 = meshInfo.AddEdge(v0, v1);
 			
 			// set face 0
-			edgeInfo01->m_face0 = faceInfo;
+			meshInfo.Edge(edgeInfo01)->m_face0 = faceIndex;
 		}
 		else 
 		{
-			if (edgeInfo01->m_face1 != nullptr)
+			if (meshInfo.Edge(edgeInfo01)->m_face1 != NV_INVALID_INDEX)
 			{
 				fprintf(stderr, "BuildStripifyInfo: > 2 triangles on an edge... uncertain consequences\n");
+				bOffEdge01 = true;
 			}
 			else
 			{
-				edgeInfo01->m_face1 = faceInfo;
+				meshInfo.Edge(edgeInfo01)->m_face1 = faceIndex;
 				bFaceUpdated[0] = true;
 			}
 		}
 		
 		// grab the edge infos, creating them if they do not already exist
-		NvEdgeInfo *edgeInfo12 = FindEdgeInfo(edgeInfos, v1, v2);
-		if (edgeInfo12 == nullptr)
+		NvIndex edgeInfo12 = meshInfo.FindEdgeIndex(v1, v2);
+		if (edgeInfo12 == NV_INVALID_INDEX)
 		{
 			bMightAlreadyExist = false;
 			
-			// create the info
-			edgeInfo12 = new NvEdgeInfo(v1, v2);
-			
-			// update the linked list on both 
-			edgeInfo12->m_nextV0 = edgeInfos[v1];
-			edgeInfo12->m_nextV1 = edgeInfos[v2];
-			edgeInfos[v1] = edgeInfo12;
-			edgeInfos[v2] = edgeInfo12;
+			// create the info, this updates the linked list on both 
+			edgeInfo12 = meshInfo.AddEdge(v1, v2);
 			
 			// set face 0
-			edgeInfo12->m_face0 = faceInfo;
+			meshInfo.Edge(edgeInfo12)->m_face0 = faceIndex;
 		}
 		else 
 		{
-			if (edgeInfo12->m_face1 != nullptr)
+			if (meshInfo.Edge(edgeInfo12)->m_face1 != NV_INVALID_INDEX)
 			{
 				fprintf(stderr, "BuildStripifyInfo: > 2 triangles on an edge... uncertain consequences\n");
 			}
 			else
 			{
-				edgeInfo12->m_face1 = faceInfo;
+				meshInfo.Edge(edgeInfo12)->m_face1 = faceIndex;
 				bFaceUpdated[1] = true;
 			}
 		}
 		
 		// grab the edge infos, creating them if they do not already exist
-		NvEdgeInfo *edgeInfo20 = FindEdgeInfo(edgeInfos, v2, v0);
-		if (edgeInfo20 == nullptr)
+		NvIndex edgeInfo20 = meshInfo.FindEdgeIndex(v2, v0);
+		if (edgeInfo20 == NV_INVALID_INDEX)
 		{
 			bMightAlreadyExist = false;
 
-			// create the info
-			edgeInfo20 = new NvEdgeInfo(v2, v0);
-			
-			// update the linked list on both 
-			edgeInfo20->m_nextV0 = edgeInfos[v2];
-			edgeInfo20->m_nextV1 = edgeInfos[v0];
-			edgeInfos[v2] = edgeInfo20;
-			edgeInfos[v0] = edgeInfo20;
+			// create the info, this updates the linked list on both 
+			edgeInfo20 = meshInfo.AddEdge(v2, v0);
 			
 			// set face 0
-			edgeInfo20->m_face0 = faceInfo;
+			meshInfo.Edge(edgeInfo20)->m_face0 = faceIndex;
 		}
 		else 
 		{
-			if (edgeInfo20->m_face1 != nullptr)
+			if (meshInfo.Edge(edgeInfo20)->m_face1 != NV_INVALID_INDEX)
 			{
 				fprintf(stderr, "BuildStripifyInfo: > 2 triangles on an edge... uncertain consequences\n");
 			}
 			else
 			{
-				edgeInfo20->m_face1 = faceInfo;
+				meshInfo.Edge(edgeInfo20)->m_face1 = faceIndex;
 				bFaceUpdated[2] = true;
 			}
 		}
 
-		if(bMightAlreadyExist)
+		if(bMightAlreadyExist && AlreadyExists(meshInfo.Face(faceIndex), meshInfo, meshInfo.Edge(edgeInfo01)))
 		{
-			if(!AlreadyExists(faceInfo, faceInfos))
-				faceInfos.emplace_back(faceInfo);
-			else
-			{
-				delete faceInfo;
-
-				//cleanup pointers that point to this deleted face
-				if(bFaceUpdated[0])
-					edgeInfo01->m_face1 = nullptr;
-				if(bFaceUpdated[1])
-					edgeInfo12->m_face1 = nullptr;
-				if(bFaceUpdated[2])
-					edgeInfo20->m_face1 = nullptr;
-			}
+			meshInfo.RemoveLastFace();
+
+			//cleanup indices that point to this deleted face
+			if(bFaceUpdated[0])
+				meshInfo.Edge(edgeInfo01)->m_face1 = NV_INVALID_INDEX;
+			if(bFaceUpdated[1])
+				meshInfo.Edge(edgeInfo12)->m_face1 = NV_INVALID_INDEX;
+			if(bFaceUpdated[2])
+				meshInfo.Edge(edgeInfo20)->m_face1 = NV_INVALID_INDEX;
 		}
-		else
+		else if(bOffEdge01)
 		{
-			faceInfos.emplace_back(faceInfo);
+			//its copies won't find it on the edge, so they have to find it here
+			meshInfo.AddOffEdgeFace(meshInfo.Face(faceIndex));
 		}
-
 	}
 }
 
@@ -255,21 +285,24 @@ void NvStripifier::BuildStripifyInfo(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &ed
 // FindStartPoint()
 //
 // Finds a good starting point, namely one which has only one neighbor
+// Returns where it is among the reset faces
 //
-std::ptrdiff_t NvStripifier::FindStartPoint(const NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos)
+std::ptrdiff_t NvStripifier::FindStartPoint(NvMeshInfo &meshInfo)
 {
 	int bestCtr = -1;
-	std::ptrdiff_t bestIndex = -1, i = 0;
+	std::ptrdiff_t bestIndex = -1;
+	std::ptrdiff_t numFaces = static_cast<std::ptrdiff_t>(NumResetFaces(meshInfo));
 
-	for(auto &f : faceInfos)
+	for(std::ptrdiff_t i = 0; i < numFaces; i++)
 	{
+		const NvFaceInfo *f = meshInfo.Face(ResetFace(static_cast<size_t>(i)));
 		int ctr = 0;
 		
-		if(FindOtherFace(edgeInfos, f->m_v0, f->m_v1, f) == nullptr)
+		if(FindOtherFace(meshInfo, f->m_v0, f->m_v1, f) == nullptr)
 			ctr++;
-		if(FindOtherFace(edgeInfos, f->m_v1, f->m_v2, f) == nullptr)
+		if(FindOtherFace(meshInfo, f->m_v1, f->m_v2, f) == nullptr)
 			ctr++;
-		if(FindOtherFace(edgeInfos, f->m_v2, f->m_v0, f) == nullptr)
+		if(FindOtherFace(meshInfo, f->m_v2, f->m_v0, f) == nullptr)
 			ctr++;
 
 		if(ctr > bestCtr)
@@ -277,8 +310,6 @@ std::ptrdiff_t NvStripifier::FindStartPoint(const NvFaceInfoVec &faceInfos, NvEd
 			bestCtr = ctr;
 			bestIndex = i;
 		}
-
-		++i;
 	}
 	
 	if(bestCtr == 0)
@@ -295,19 +326,19 @@ std::ptrdiff_t NvStripifier::FindStartPoint(const NvFaceInfoVec &faceInfos, NvEd
 // we know that when we've made the longest strips its because
 // we're stripifying in the same general orientation.
 //
-NvFaceInfo* NvStripifier::FindGoodResetPoint(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos){
+NvFaceInfo* NvStripifier::FindGoodResetPoint(NvMeshInfo &meshInfo){
 	// we hop into different areas of the mesh to try to get
 	// other large open spans done.  Areas of small strips can
 	// just be left to triangle lists added at the end.
 	NvFaceInfo *result = nullptr;
 	
 	{
-		size_t numFaces   = faceInfos.size();
+		size_t numFaces   = NumResetFaces(meshInfo);
 		std::ptrdiff_t startPoint;
 		if(bFirstTimeResetPoint)
 		{
 			//first time, find a face with few neighbors (look for an edge of the mesh)
-			startPoint = FindStartPoint(faceInfos, edgeInfos);
+			startPoint = FindStartPoint(meshInfo);
 			bFirstTimeResetPoint = false;
 		}
 		else
@@ -330,8 +361,8 @@ NvFaceInfo* NvStripifier::FindGoodResetPoint(NvFaceInfoVec &faceInfos, NvEdgeInf
 		do {
 			
 			// if this guy isn't visited, try him
-			if (faceInfos[i]->m_stripId < 0){
-				result = faceInfos[i];
+			if (meshInfo.StripId(ResetFace(static_cast<size_t>(i))) < 0){
+				result = meshInfo.Face(ResetFace(static_cast<size_t>(i)));
 				break;
 			}
 			
@@ -490,8 +521,14 @@ inline int NvStripifier::GetNextIndex(const UIntVec &indices, NvFaceInfo *face){
 // already assign to a committed strip OR it is assigned in an
 // experiment and the experiment index is the one we are building
 // for, then it is marked and unavailable
-inline bool NvStripInfo::IsMarked(NvFaceInfo *faceInfo) const {
-	return (faceInfo->m_stripId >= 0) || (IsExperiment() && faceInfo->m_experimentId == m_experimentId);
+// (see NvExperimentWorkspace for how we tell which experiment took a face)
+//
+// The degenerate faces we make up while building don't belong to the mesh, and are never marked
+inline bool NvStripInfo::IsMarked(NvMeshInfo &meshInfo, NvFaceInfo *faceInfo) const {
+	if(faceInfo->m_index == NV_INVALID_INDEX)
+		return false;
+
+	return (meshInfo.StripId(faceInfo) >= 0) || (IsExperiment() && TestStripId(faceInfo) >= m_experimentId);
 }
 
 
@@ -500,58 +537,69 @@ inline bool NvStripInfo::IsMarked(NvFaceInfo *faceInfo) const {
 //
 // Marks the face with the current strip ID
 //
-inline void NvStripInfo::MarkTriangle(NvFaceInfo *faceInfo){
-	assert(!IsMarked(faceInfo));
+inline void NvStripInfo::MarkTriangle(NvMeshInfo &meshInfo, NvFaceInfo *faceInfo){
+	assert(!IsMarked(meshInfo, faceInfo));
+	if(faceInfo->m_index == NV_INVALID_INDEX)
+		return;
+
 	if (IsExperiment()){
-		faceInfo->m_experimentId = m_experimentId;
-		faceInfo->m_testStripId  = m_stripId;
+		TestStripId(faceInfo) = m_stripId;
     }
 	else{
-		assert(faceInfo->m_stripId == -1);
-		faceInfo->m_experimentId = -1;
-		faceInfo->m_stripId      = m_stripId;
+		assert(meshInfo.StripId(faceInfo) == -1);
+		meshInfo.StripId(faceInfo) = m_stripId;
 	}
 }
 
 
-bool NvStripInfo::Unique(const NvFaceInfoVec& faceVec, NvFaceInfo* face) const
+bool NvStripInfo::Unique(const NvFaceInfo* face) const
 {
-	bool bv0, bv1, bv2; //bools to indicate whether a vertex is in the faceVec or not
-	bv0 = bv1 = bv2 = false;
+	const std::vector<unsigned int> &vertexBuildIds = m_workspace->m_vertexBuildIds;
+	const unsigned int buildId = m_workspace->m_buildId;
 
-	for(auto &f : faceVec)
-	{
-		if(!bv0)
-		{
-			if( (f->m_v0 == face->m_v0) || 
-				(f->m_v1 == face->m_v0) ||
-				(f->m_v2 == face->m_v0) )
-				bv0 = true;
-		}
+	//the face is not unique if all it's vertices are in the strip already
+	return (vertexBuildIds[face->m_v0] != buildId) ||
+		   (vertexBuildIds[face->m_v1] != buildId) ||
+		   (vertexBuildIds[face->m_v2] != buildId);
+}
 
-		if(!bv1)
-		{
-			if( (f->m_v0 == face->m_v1) || 
-				(f->m_v1 == face->m_v1) ||
-				(f->m_v2 == face->m_v1) )
-				bv1 = true;
-		}
 
-		if(!bv2)
-		{
-			if( (f->m_v0 == face->m_v2) || 
-				(f->m_v1 == face->m_v2) ||
-				(f->m_v2 == face->m_v2) )
-				bv2 = true;
-		}
+///////////////////////////////////////////////////////////////////////////////////////////
+// AddVertices()
+//
+// Notes the vertices of a face going in the strip, so Unique() can tell right away
+//  whether a later face would add one, instead of looking through the whole strip
+//
+void NvStripInfo::AddVertices(const NvFaceInfo* face)
+{
+	std::vector<unsigned int> &vertexBuildIds = m_workspace->m_vertexBuildIds;
+	const unsigned int buildId = m_workspace->m_buildId;
+
+	vertexBuildIds[face->m_v0] = buildId;
+	vertexBuildIds[face->m_v1] = buildId;
+	vertexBuildIds[face->m_v2] = buildId;
+}
+
 
-		//the face is not unique, all it's vertices exist in the face vector
-		if(bv0 && bv1 && bv2)
-			return false;
+///////////////////////////////////////////////////////////////////////////////////////////
+// BeginBuild()
+//
+// Gives the next build its own id, so the vertices earlier builds put in their strips
+//  are out of this one without clearing anything.  Only when the ids run out is the
+//  whole array cleared, and the mesh may have gained vertices since the last build
+//
+void NvExperimentWorkspace::BeginBuild(size_t numVertices)
+{
+	if(m_vertexBuildIds.size() < numVertices)
+		m_vertexBuildIds.resize(numVertices, 0);
+
+	if(m_buildId == std::numeric_limits<unsigned int>::max())
+	{
+		std::fill(std::begin(m_vertexBuildIds), std::end(m_vertexBuildIds), 0);
+		m_buildId = 0;
 	}
-	
-	//if we get out here, it's unique
-	return true;
+
+	++m_buildId;
 }
 
 
@@ -560,8 +608,16 @@ bool NvStripInfo::Unique(const NvFaceInfoVec& faceVec, NvFaceInfo* face) const
 //
 // Builds a strip forward as far as we can go, then builds backwards, and joins the two lists
 //
-void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
+void NvStripInfo::Build(NvMeshInfo &meshInfo)
 {
+	NV_NVTS_PROFILE_TIMER(timer, buildStrip);
+	NV_NVTS_PROFILE_COUNT(stripsBuilt, 1);
+
+	assert(m_workspace != nullptr);
+	NvFaceInfoPool &facePool = m_workspace->m_facePool;
+	m_workspace->BeginBuild(meshInfo.NumVertices());
+
+
 	// used in building the strips forward and backward
 	UIntVec scratchIndices;
 	
@@ -569,7 +625,7 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 	NvFaceInfoVec forwardFaces, backwardFaces;
 	forwardFaces.emplace_back(m_startInfo.m_startFace);
 
-	MarkTriangle(m_startInfo.m_startFace);
+	MarkTriangle(meshInfo, m_startInfo.m_startFace);
 	
 	int v0 = (m_startInfo.m_toV1 ? m_startInfo.m_startEdge->m_v0 : m_startInfo.m_startEdge->m_v1);
 	int v1 = (m_startInfo.m_toV1 ? m_startInfo.m_startEdge->m_v1 : m_startInfo.m_startEdge->m_v0);
@@ -587,35 +643,29 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 	int nv0 = v1;
 	int nv1 = v2;
 
-	NvFaceInfo *nextFace = NvStripifier::FindOtherFace(edgeInfos, nv0, nv1, m_startInfo.m_startFace);
-	while (nextFace != nullptr && !IsMarked(nextFace))
+	NvFaceInfo *nextFace = NvStripifier::FindOtherFace(meshInfo, nv0, nv1, m_startInfo.m_startFace);
+	while (nextFace != nullptr && !IsMarked(meshInfo, nextFace))
 	{
 		//check to see if this next face is going to cause us to die soon
 		int testnv0 = nv1;
 		int testnv1 = NvStripifier::GetNextIndex(scratchIndices, nextFace);
 		
-		NvFaceInfo* nextNextFace = NvStripifier::FindOtherFace(edgeInfos, testnv0, testnv1, nextFace);
+		NvFaceInfo* nextNextFace = NvStripifier::FindOtherFace(meshInfo, testnv0, testnv1, nextFace);
 
-		if( (nextNextFace == nullptr) || (IsMarked(nextNextFace)) )
+		if( (nextNextFace == nullptr) || (IsMarked(meshInfo, nextNextFace)) )
 		{
 			//uh, oh, we're following a dead end, try swapping
-			NvFaceInfo* testNextFace = NvStripifier::FindOtherFace(edgeInfos, nv0, testnv1, nextFace);
+			NvFaceInfo* testNextFace = NvStripifier::FindOtherFace(meshInfo, nv0, testnv1, nextFace);
 
-			if( ((testNextFace != nullptr) && !IsMarked(testNextFace)) )
+			if( ((testNextFace != nullptr) && !IsMarked(meshInfo, testNextFace)) )
 			{
 				//we only swap if it buys us something
 				
 				//add a "fake" degenerate face
-				NvFaceInfo* tempFace = new NvFaceInfo(nv0, nv1, nv0);
-				
-// START EPIC MOD: Fix memory leak
-				// We need to store this pointer to avoid a memory leak from the experiments that didn't make it. Only the experiment
-				// that passes has its degenerates deleted. Add the pointer to the member vector for this StripInfo
-				m_Degenerates.emplace_back( tempFace );
-// END EPIC MOD: Fix memory leak
+				NvFaceInfo* tempFace = facePool.New(nv0, nv1, nv0);
 
 				forwardFaces.emplace_back(tempFace);
-				MarkTriangle(tempFace);
+				MarkTriangle(meshInfo, tempFace);
 
 				scratchIndices.emplace_back(nv0);
 				testnv0 = nv0;
@@ -629,7 +679,7 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 // EPIC NOTE: Is this correct? If we've just pushed back tempFace then surely this is wrong...
 		forwardFaces.emplace_back(nextFace);
 
-		MarkTriangle(nextFace);
+		MarkTriangle(meshInfo, nextFace);
 		
 		// add the index
 		//nv0 = nv1;
@@ -642,14 +692,13 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 		nv0 = testnv0;
 		nv1 = testnv1;
 
-		nextFace = NvStripifier::FindOtherFace(edgeInfos, nv0, nv1, nextFace);
+		nextFace = NvStripifier::FindOtherFace(meshInfo, nv0, nv1, nextFace);
 	
 	}
 	
-	// tempAllFaces is going to be forwardFaces + backwardFaces
-	// it's used for Unique()
-	NvFaceInfoVec tempAllFaces;
-	std::copy(std::begin(forwardFaces), std::end(forwardFaces), std::back_inserter(tempAllFaces));
+	// the vertices of forwardFaces, and then of backwardFaces, are what Unique() checks against
+	for(auto &f : forwardFaces)
+		AddVertices(f);
 
 	//
 	// reset the indices for building the strip backwards and do so
@@ -660,39 +709,33 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 	scratchIndices.emplace_back(v0);
 	nv0 = v1;
 	nv1 = v0;
-	nextFace = NvStripifier::FindOtherFace(edgeInfos, nv0, nv1, m_startInfo.m_startFace);
-	while (nextFace != nullptr && !IsMarked(nextFace))
+	nextFace = NvStripifier::FindOtherFace(meshInfo, nv0, nv1, m_startInfo.m_startFace);
+	while (nextFace != nullptr && !IsMarked(meshInfo, nextFace))
 	{
 		//this tests to see if a face is "unique", meaning that its vertices aren't already in the list
 		// so, strips which "wrap-around" are not allowed
-		if(!Unique(tempAllFaces, nextFace))
+		if(!Unique(nextFace))
 			break;
 
 		//check to see if this next face is going to cause us to die soon
 		int testnv0 = nv1;
 		int testnv1 = NvStripifier::GetNextIndex(scratchIndices, nextFace);
 		
-		NvFaceInfo* nextNextFace = NvStripifier::FindOtherFace(edgeInfos, testnv0, testnv1, nextFace);
+		NvFaceInfo* nextNextFace = NvStripifier::FindOtherFace(meshInfo, testnv0, testnv1, nextFace);
 
-		if( (nextNextFace == nullptr) || (IsMarked(nextNextFace)) )
+		if( (nextNextFace == nullptr) || (IsMarked(meshInfo, nextNextFace)) )
 		{
 			//uh, oh, we're following a dead end, try swapping
-			NvFaceInfo* testNextFace = NvStripifier::FindOtherFace(edgeInfos, nv0, testnv1, nextFace);
-			if( ((testNextFace != nullptr) && !IsMarked(testNextFace)) )
+			NvFaceInfo* testNextFace = NvStripifier::FindOtherFace(meshInfo, nv0, testnv1, nextFace);
+			if( ((testNextFace != nullptr) && !IsMarked(meshInfo, testNextFace)) )
 			{
 				//we only swap if it buys us something
 				
 				//add a "fake" degenerate face
-				NvFaceInfo* tempFace = new NvFaceInfo(nv0, nv1, nv0);
-
-// START EPIC MOD: Fix memory leak
-				// We need to store this pointer to avoid a memory leak from the experiments that didn't make it. Only the experiment
-				// that passes has its degenerates deleted. Add the pointer to the member vector for this StripInfo - Paul Fotheringham
-				m_Degenerates.emplace_back( tempFace );
-// END EPIC MOD: Fix memory leak
+				NvFaceInfo* tempFace = facePool.New(nv0, nv1, nv0);
 
 				backwardFaces.emplace_back(tempFace);
-				MarkTriangle(tempFace);
+				MarkTriangle(meshInfo, tempFace);
 				scratchIndices.emplace_back(nv0);
 				testnv0 = nv0;
 
@@ -705,9 +748,9 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 		backwardFaces.emplace_back(nextFace);
 		
 		//this is just so Unique() will work
-		tempAllFaces.emplace_back(nextFace);
+		AddVertices(nextFace);
 
-		MarkTriangle(nextFace);
+		MarkTriangle(meshInfo, nextFace);
 		
 		// add the index
 		//nv0 = nv1;
@@ -717,7 +760,7 @@ void NvStripInfo::Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &)
 		// and get the next face
 		nv0 = testnv0;
 		nv1 = testnv1;
-		nextFace = NvStripifier::FindOtherFace(edgeInfos, nv0, nv1, nextFace);
+		nextFace = NvStripifier::FindOtherFace(meshInfo, nv0, nv1, nextFace);
 	}
 	
 	// Combine the forward and backwards stripification lists and put into our own face vector
@@ -748,24 +791,24 @@ void NvStripInfo::Combine(const NvFaceInfoVec &forward, const NvFaceInfoVec &bac
 //
 // Returns true if the input face and the current strip share an edge
 //
-bool NvStripInfo::SharesEdge(const NvFaceInfo* faceInfo, NvEdgeInfoVec &edgeInfos) const
+bool NvStripInfo::SharesEdge(const NvFaceInfo* faceInfo, NvMeshInfo &meshInfo) const
 {
 	//check v0->v1 edge
-	NvEdgeInfo* currEdge = NvStripifier::FindEdgeInfo(edgeInfos, faceInfo->m_v0, faceInfo->m_v1);
+	NvEdgeInfo* currEdge = NvStripifier::FindEdgeInfo(meshInfo, faceInfo->m_v0, faceInfo->m_v1);
 	
-	if(IsInStrip(currEdge->m_face0) || IsInStrip(currEdge->m_face1))
+	if(IsInStrip(meshInfo, meshInfo.Face(currEdge->m_face0)) || IsInStrip(meshInfo, meshInfo.Face(currEdge->m_face1)))
 		return true;
 	
 	//check v1->v2 edge
-	currEdge = NvStripifier::FindEdgeInfo(edgeInfos, faceInfo->m_v1, faceInfo->m_v2);
+	currEdge = NvStripifier::FindEdgeInfo(meshInfo, faceInfo->m_v1, faceInfo->m_v2);
 	
-	if(IsInStrip(currEdge->m_face0) || IsInStrip(currEdge->m_face1))
+	if(IsInStrip(meshInfo, meshInfo.Face(currEdge->m_face0)) || IsInStrip(meshInfo, meshInfo.Face(currEdge->m_face1)))
 		return true;
 	
 	//check v2->v0 edge
-	currEdge = NvStripifier::FindEdgeInfo(edgeInfos, faceInfo->m_v2, faceInfo->m_v0);
+	currEdge = NvStripifier::FindEdgeInfo(meshInfo, faceInfo->m_v2, faceInfo->m_v0);
 	
-	if(IsInStrip(currEdge->m_face0) || IsInStrip(currEdge->m_face1))
+	if(IsInStrip(meshInfo, meshInfo.Face(currEdge->m_face0)) || IsInStrip(meshInfo, meshInfo.Face(currEdge->m_face1)))
 		return true;
 	
 	return false;
@@ -784,8 +827,10 @@ void NvStripifier::CommitStrips(NvStripInfoVec &allStrips, const NvStripInfoVec
 	// Iterate through strips
 	for (auto *strip : strips){
 
-		// Tell the strip that it is now real
+		// Tell the strip that it is now real, its experiment's strip
+		// id only meant something in the workspace it was built in
 		strip->m_experimentId = -1;
+		strip->m_stripId      = static_cast<int>(allStrips.size());
 		
 		// add to the list of real strips
 		allStrips.emplace_back(strip);
@@ -794,7 +839,7 @@ void NvStripifier::CommitStrips(NvStripInfoVec &allStrips, const NvStripInfoVec
 		// Tell the faces of the strip that they belong to a real strip now
 		for (auto &f : strip->m_faces)
 		{
-			strip->MarkTriangle(f);
+			strip->MarkTriangle(meshInfo, f);
 		}
 	}
 }
@@ -805,38 +850,40 @@ void NvStripifier::CommitStrips(NvStripInfoVec &allStrips, const NvStripInfoVec
 //
 // Finds the next face to start the next strip on.
 //
-bool NvStripifier::FindTraversal(NvFaceInfoVec    &,
-								 NvEdgeInfoVec    &edgeInfos,
+bool NvStripifier::FindTraversal(NvMeshInfo       &meshInfo,
 								 NvStripInfo      *strip,
 								 NvStripStartInfo &startInfo){
+	NV_NVTS_PROFILE_TIMER(timer, findTraversal);
+	NV_NVTS_PROFILE_CHAIN(edgeSteps, traversalEdgeSteps, maxTraversalEdgeSteps);
 	
 	// if the strip was v0->v1 on the edge, then v1 will be a vertex in the next edge.
 	int v = (strip->m_startInfo.m_toV1 ? strip->m_startInfo.m_startEdge->m_v1 : strip->m_startInfo.m_startEdge->m_v0);
 	
 	NvFaceInfo *untouchedFace = nullptr;
-	NvEdgeInfo *edgeIter      = edgeInfos[v];
+	NvEdgeInfo *edgeIter      = meshInfo.FirstEdge(v);
 	while (edgeIter != nullptr){
-		NvFaceInfo *face0 = edgeIter->m_face0;
-		NvFaceInfo *face1 = edgeIter->m_face1;
-		if ((face0 != nullptr && !strip->IsInStrip(face0)) && face1 != nullptr && !strip->IsMarked(face1))
+		NV_NVTS_PROFILE_STEP(edgeSteps);
+		NvFaceInfo *face0 = meshInfo.Face(edgeIter->m_face0);
+		NvFaceInfo *face1 = meshInfo.Face(edgeIter->m_face1);
+		if ((face0 != nullptr && !strip->IsInStrip(meshInfo, face0)) && face1 != nullptr && !strip->IsMarked(meshInfo, face1))
 		{
 			untouchedFace = face1;
 			break;
 		}
-		if ((face1 != nullptr && !strip->IsInStrip(face1)) && face0 != nullptr && !strip->IsMarked(face0)){
+		if ((face1 != nullptr && !strip->IsInStrip(meshInfo, face1)) && face0 != nullptr && !strip->IsMarked(meshInfo, face0)){
 			untouchedFace = face0;
 			break;
 		}
 		
 		// find the next edgeIter
-		edgeIter = (edgeIter->m_v0 == v ? edgeIter->m_nextV0 : edgeIter->m_nextV1);
+		edgeIter = meshInfo.NextEdge(edgeIter, v);
 	}
 	
 	startInfo.m_startFace = untouchedFace;
 	startInfo.m_startEdge = edgeIter;
 	if (edgeIter != nullptr)
 	{
-		if(strip->SharesEdge(startInfo.m_startFace, edgeInfos))
+		if(strip->SharesEdge(startInfo.m_startFace, meshInfo))
 			startInfo.m_toV1 = (edgeIter->m_v0 == v);  //note! used to be m_v1
 		else
 			startInfo.m_toV1 = (edgeIter->m_v1 == v);
@@ -848,12 +895,14 @@ bool NvStripifier::FindTraversal(NvFaceInfoVec    &,
 ////////////////////////////////////////////////////////////////////////////////////////
 // RemoveSmallStrips()
 //
-// allStrips is the whole strip vector...all small strips will be deleted from this list, to avoid leaking mem
+// allStrips is the whole strip vector...all small strips will be deleted from this list, their faces go to faceList
 // allBigStrips is an out parameter which will contain all strips above minStripLength
 // faceList is an out parameter which will contain all faces which were removed from the striplist
 //
 void NvStripifier::RemoveSmallStrips(NvStripInfoVec& allStrips, NvStripInfoVec& allBigStrips, NvFaceInfoVec& faceList)
 {
+	NV_NVTS_PROFILE_TIMER(timer, removeSmallStrips);
+
 	faceList.clear();
 	allBigStrips.clear();  //make sure these are empty
 	NvFaceInfoVec tempFaceList;
@@ -867,7 +916,7 @@ void NvStripifier::RemoveSmallStrips(NvStripInfoVec& allStrips, NvStripInfoVec&
 				tempFaceList.emplace_back(f);
 			
 			//and free memory
-			delete as;
+			stripPool.Delete(as);
 		}
 		else
 		{
@@ -877,38 +926,33 @@ void NvStripifier::RemoveSmallStrips(NvStripInfoVec& allStrips, NvStripInfoVec&
 	
 	if(tempFaceList.size())
 	{
-		std::unique_ptr<bool[]> bVisitedList = std::make_unique<bool[]>(tempFaceList.size());
-		memset(bVisitedList.get(), 0, tempFaceList.size()*sizeof(bool));
-
-		std::unique_ptr<VertexCache> vcache = std::make_unique<VertexCache>(cacheSize);
+		VertexCache vcache(cacheSize, cachePolicy, meshInfo.NumVertices());
 
-		int numHits;
-		std::ptrdiff_t bestIndex = 0;
+		//each face goes in as a strip of its own, filed by how many of its vertices
+		// are in the cache, so we never have to look at all of them to find the best
+		StripOrderQueue queue;
+		std::vector<int> faceVertices(3);
+		for(auto &f : tempFaceList)
+		{
+			faceVertices[0] = f->m_v0;
+			faceVertices[1] = f->m_v1;
+			faceVertices[2] = f->m_v2;
+			queue.AddStrip(faceVertices, 1, false);
+		}
+		queue.Build(meshInfo.NumVertices());
 
 		while(1)
 		{
-			int bestNumHits = -1;
-
-			//find best face to add next, given the current cache
-			for(std::ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(tempFaceList.size()); i++)
-			{
-				if(bVisitedList[i])
-					continue;
-
-				numHits = CalcNumHitsFace(vcache.get(), tempFaceList[i]);
-				if(numHits > bestNumHits)
-				{
-					bestNumHits = numHits;
-					bestIndex = i;
-				}
-			}
+			//find best face to add next, given the current cache.
+			// the first one with the most hits
+			size_t bestIndex = queue.Next();
 
-			if(bestNumHits == -1)
+			if(bestIndex == StripOrderQueue::NONE)
 				break;
 
-			bVisitedList[bestIndex] = true;
+			queue.Remove(bestIndex);
 
-			UpdateCacheFace(vcache.get(), tempFaceList[bestIndex]);
+			UpdateCacheFace(&vcache, tempFaceList[bestIndex], &queue);
 
 			faceList.emplace_back(tempFaceList[bestIndex]);
 		}
@@ -947,18 +991,23 @@ bool NvStripifier::IsCW(NvFaceInfo *faceInfo, int v0, int v1)
 //
 // Generates actual strips from the list-in-strip-order.
 //
-void NvStripifier::CreateStrips(const NvStripInfoVec& allStrips, IntVec& stripIndices, 
+template<typename IndexT>
+void NvStripifier::CreateStrips(const NvStripInfoVec& allStrips, std::vector<IndexT>& stripIndices, 
 								const bool bStitchStrips, size_t& numSeparateStrips)
 {
 	assert(numSeparateStrips == 0);
 
+	NV_NVTS_PROFILE_THREAD(threadProfile, profile);
+	NV_NVTS_PROFILE_TIMER(timer, createStrips);
+	auto phaseStart = std::chrono::steady_clock::now();
+
 	NvFaceInfo tLastFace(0, 0, 0);
 	NvFaceInfo tPrevStripLastFace(0, 0, 0);
 	size_t nStripCount = allStrips.size();
 	assert(nStripCount > 0);
 
 	//we infer the cw/ccw ordering depending on the number of indices
-	//this is screwed up by the fact that we insert -1s to denote changing strips
+	//this is screwed up by the fact that we insert restart indices to denote changing strips
 	//this is to account for that
 	int accountForNegatives = 0;
 
@@ -1066,8 +1115,8 @@ void NvStripifier::CreateStrips(const NvStripInfoVec& allStrips, IntVec& stripIn
 		}
 		else
 		{
-			//-1 index indicates next strip
-			stripIndices.emplace_back(-1);
+			//restart index indicates next strip
+			stripIndices.emplace_back(STRIP_RESTART_INDEX<IndexT>);
 			accountForNegatives++;
 			numSeparateStrips++;
 		}
@@ -1080,6 +1129,8 @@ void NvStripifier::CreateStrips(const NvStripInfoVec& allStrips, IntVec& stripIn
 	
 	if(bStitchStrips)
 		numSeparateStrips = 1;
+
+	phaseTimes.createStrips = SecondsSince(phaseStart);
 }
 
 
@@ -1090,56 +1141,120 @@ void NvStripifier::CreateStrips(const NvStripInfoVec& allStrips, IntVec& stripIn
 // in_indices are the input indices of the mesh to stripify
 // in_cacheSize is the target cache size 
 //
-void NvStripifier::Stripify(const UIntVec &in_indices, const int in_cacheSize, 
+template<typename IndexT>
+void NvStripifier::Stripify(const IndexT* in_indices, const size_t in_numIndices, const int in_cacheSize, 
 							const size_t in_minStripLength, const size_t maxIndex, 
 							NvStripInfoVec &outStrips, NvFaceInfoVec& outFaceList)
 {
-	meshJump = 0.0f;
-	bFirstTimeResetPoint = true; //used in FindGoodResetPoint()
+	SetSizes(in_cacheSize, in_minStripLength);
+
+	//this thread counts into the stripifier's own profile, the experiments into their workspace's
+#ifdef NV_NVTS_ENABLE_PROFILING
+	profile = StripifyProfile();
+#endif
+	NV_NVTS_PROFILE_THREAD(threadProfile, profile);
+	
+	bCancelled.store(false);
+	if(!ReportProgress(StripifyPhase::SP_BUILD_STRIPIFY_INFO, 0, in_numIndices / 3))
+		return;
+
+	// build the stripification info
+	auto phaseStart = std::chrono::steady_clock::now();
+	BuildStripifyInfo(meshInfo, in_indices, in_numIndices, maxIndex);
+	phaseTimes.buildStripifyInfo = SecondsSince(phaseStart);
 
-	//the number of times to run the experiments
-	constexpr int numSamples = 10;
+	//nothing left to strip, not even a list
+	if(meshInfo.NumFaces() == 0)
+		return;
 	
+	workspaces.clear();
+	StripifyFreeFaces(outStrips, outFaceList);
+
+	//clean up, the strips go along with the faces and edges when we do
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// SetSizes()
+//
+// in_cacheSize is the target cache size, in_minStripLength the smallest strip we keep
+//
+void NvStripifier::SetSizes(const int in_cacheSize, const size_t in_minStripLength)
+{
 	//the cache size, clamped to one
 	cacheSize = std::max(1, in_cacheSize - CACHE_INEFFICIENCY);
 	
 	minStripLength = in_minStripLength;  //this is the strip size threshold below which we dump the strip into a list
-	
-	indices = in_indices;
-	
-	// build the stripification info
-	NvFaceInfoVec allFaceInfos;
-	NvEdgeInfoVec allEdgeInfos;
-	
-	BuildStripifyInfo(allFaceInfos, allEdgeInfos, maxIndex);
-	
-	NvStripInfoVec allStrips;
+}
 
-	// stripify
-	FindAllStrips(allStrips, allFaceInfos, allEdgeInfos, numSamples);
-	
-	//split up the strips into cache friendly pieces, optimize them, then dump these into outStrips
-	SplitUpStripsAndOptimize(allStrips, outStrips, allEdgeInfos, outFaceList);
 
-	//clean up
-	for (auto &as : allStrips)
-	{
-		delete as;
-	}
-	
-	std::ptrdiff_t i = 0;
-	for (auto *info : allEdgeInfos)
+///////////////////////////////////////////////////////////////////////////////////////////
+// ReportProgress()
+//
+// Tells the progress callback how far along we are, and remembers if it said to stop
+//
+bool NvStripifier::ReportProgress(StripifyPhase phase, size_t done, size_t total)
+{
+	if(progressCallback == nullptr)
+		return true;
+
+	std::lock_guard<std::mutex> lock(progressMutex);
+	if( !bCancelled.load(std::memory_order_relaxed) && !progressCallback(StripifyProgress(phase, done, total), progressUserData) )
+		bCancelled.store(true, std::memory_order_relaxed);
+
+	return !bCancelled.load(std::memory_order_relaxed);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// StripifyFreeFaces()
+//
+// Builds strips out of the faces of the mesh which aren't in a strip yet, starting them on
+//  the reset faces, and orders them, and the faces left for the list, for the cache.
+//  Whatever the workspaces already hold stays, so earlier strips stay valid.
+//
+void NvStripifier::StripifyFreeFaces(NvStripInfoVec &outStrips, NvFaceInfoVec &outFaceList)
+{
+	meshJump = 0.0f;
+	bFirstTimeResetPoint = true; //used in FindGoodResetPoint()
+
+	// room for a workspace per thread which might run experiments, and in the ones we
+	//  have for every face the mesh has now
+	workspaces.resize(std::max<size_t>(workspaces.size(), threadPool != nullptr ? threadPool->GetNumThreads() : 1));
+	for(auto &workspace : workspaces)
 	{
-		while (info != nullptr)
+		if(workspace)
 		{
-			NvEdgeInfo *next = (info->m_v0 == i ? info->m_nextV0 : info->m_nextV1);
-			info->Unref();
-			info = next;
+			workspace->m_testStripIds.resize(meshInfo.NumFaces(), -1);
+#ifdef NV_NVTS_ENABLE_PROFILING
+			workspace->m_profile = StripifyProfile();
+#endif
 		}
+	}
 
-		i++;
+	NvStripInfoVec allStrips;
+
+	// stripify
+	auto phaseStart = std::chrono::steady_clock::now();
+	FindAllStrips(allStrips, meshInfo, numSamples);
+	phaseTimes.findAllStrips = SecondsSince(phaseStart);
+
+	//cancelled strips are never split up, only freed
+	if(bCancelled.load())
+	{
+		for(auto *strip : allStrips)
+			strip->m_workspace->m_stripPool.Delete(strip);
+		return;
 	}
 	
+	//split up the strips into cache friendly pieces, optimize them, then dump these into outStrips
+	phaseStart = std::chrono::steady_clock::now();
+	SplitUpStripsAndOptimize(allStrips, outStrips, meshInfo, outFaceList);
+	phaseTimes.splitUpStripsAndOptimize = SecondsSince(phaseStart);
+
+	//the pieces have their faces now, the degenerate ones stay in the workspaces
+	for(auto *strip : allStrips)
+		strip->m_workspace->m_stripPool.Delete(strip);
 }
 
 
@@ -1173,10 +1288,21 @@ bool NvStripifier::IsDegenerate(const unsigned int v0, const unsigned int v1, co
 // The final strips are output through outStrips
 //
 void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripInfoVec &outStrips,
-                                            NvEdgeInfoVec& edgeInfos, NvFaceInfoVec& outFaceList)
+                                            NvMeshInfo& meshInfo, NvFaceInfoVec& outFaceList)
 {
+	NV_NVTS_PROFILE_TIMER(timer, splitUpStripsAndOptimize);
+
 	int threshold = cacheSize;
 	NvStripInfoVec tempStrips;
+
+	//a strip following another along its length saves at most a vertex for every other
+	// face, so a piece shorter than this costs more to join than it can save
+	if(costs.bEnabled && (costs.vertexCost > 0.0f))
+	{
+		const float breakEven = std::ceil(2.0f * costs.joinCost / costs.vertexCost);
+		threshold = static_cast<int>(std::min<float>(std::max<float>(static_cast<float>(threshold), breakEven),
+													 static_cast<float>(std::numeric_limits<int>::max() / 2)));
+	}
 	
 	//split up strips into threshold-sized pieces
 	for(auto &as : allStrips)
@@ -1184,12 +1310,10 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 		NvStripInfo* currentStrip;
 		NvStripStartInfo startInfo(nullptr, nullptr, false);
 	
-		ptrdiff_t actualStripSize = std::count_if(std::begin(as->m_faces),
-			std::end(as->m_faces),
-			[*this](const NvFaceInfo *f) noexcept
-			{
-				return !IsDegenerate(f);
-			});
+		//Build() counted the degenerates it put in, so there's no need to look for them
+		ptrdiff_t actualStripSize = static_cast<ptrdiff_t>(as->m_faces.size()) - as->m_numDegenerates;
+		assert(actualStripSize == std::count_if(std::begin(as->m_faces), std::end(as->m_faces),
+			[](const NvFaceInfo *f) noexcept { return !IsDegenerate(f); }));
 
 		if(actualStripSize > threshold)
 		{
@@ -1201,7 +1325,7 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 			ptrdiff_t j;
 			for(j = 0; j < numTimes; j++)
 			{
-				currentStrip = new NvStripInfo(startInfo, 0, -1);
+				currentStrip = stripPool.New(startInfo, 0, -1);
 				
 				ptrdiff_t faceCtr = j*threshold + degenerateCount;
 				bool bFirstTime = true;
@@ -1219,12 +1343,7 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 							currentStrip->m_faces.emplace_back(as->m_faces[faceCtr++]);
 						}
 						else
-// START EPIC MOD: Fix memory leak
-						{
-							delete as->m_faces[ faceCtr ];
 							++faceCtr;
-						}
-// END EPIC MOD: Fix memory leak
 					}
 					else
 					{
@@ -1263,7 +1382,7 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 			
 			if(numLeftover != 0)
 			{
-				currentStrip = new NvStripInfo(startInfo, 0, -1);   
+				currentStrip = stripPool.New(startInfo, 0, -1);   
 				
 				ptrdiff_t ctr = 0;
 				bool bFirstTime = true;
@@ -1278,12 +1397,7 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 					else if(!bFirstTime)
 						currentStrip->m_faces.emplace_back(as->m_faces[leftOff++]);
 					else
-// START EPIC MOD: Fix memory leak
-					{
-						delete as->m_faces[ leftOff ];
 						++leftOff;
-					}
-// END EPIC MOD: Fix memory leak
 				}
 				
 				tempStrips.emplace_back(currentStrip);
@@ -1292,8 +1406,8 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 		else
 		{
 			//we're not just doing a tempStrips.emplace_back(allBigStrips[i]) because
-			// this way we can delete allBigStrips later to free the memory
-			currentStrip = new NvStripInfo(startInfo, 0, -1);
+			// this way we can delete allStrips later to free the memory
+			currentStrip = stripPool.New(startInfo, 0, -1);
 			
 			for(auto &f : as->m_faces)
 				currentStrip->m_faces.emplace_back(f);
@@ -1311,13 +1425,13 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 //	for(i = 0; i < tempStrips.size(); ++i)
 //    outStrips.emplace_back(tempStrips[i]);
 	
+	if(!ReportProgress(StripifyPhase::SP_SPLIT_UP_STRIPS, 0, tempStrips2.size()))
+		return;
+
 	if(tempStrips2.size() != 0)
 	{
 		//Optimize for the vertex cache
-		VertexCache* vcache = new VertexCache(cacheSize);
-		
-		float numHits;
-		std::ptrdiff_t bestIndex = 0;
+		VertexCache vcache(cacheSize, cachePolicy, meshInfo.NumVertices());
 		
 		size_t firstIndex = 0, j = 0;
 		float minCost = 10000.0f;
@@ -1328,7 +1442,7 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 			int numNeighbors = std::accumulate(std::begin(ts->m_faces), std::end(ts->m_faces),
 				0,
 				[&](int acc, const NvFaceInfo* right) noexcept {
-					return acc + NumNeighbors(right, edgeInfos);
+					return acc + NumNeighbors(right, meshInfo);
 				});
 			
 			float currCost = (float)numNeighbors / (float)ts->m_faces.size();
@@ -1341,88 +1455,56 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 			++j;
 		}
 		
-		UpdateCacheStrip(vcache, tempStrips2[firstIndex]);
+		//file every strip by its cache hits, so we can keep picking the best one out
+		// without looking at all of them every time
+		StripOrderQueue queue;
+		std::vector<int> stripVertices;
+		for(auto &ts : tempStrips2)
+		{
+			stripVertices.clear();
+			for(auto &f : ts->m_faces)
+			{
+				stripVertices.emplace_back(f->m_v0);
+				stripVertices.emplace_back(f->m_v1);
+				stripVertices.emplace_back(f->m_v2);
+			}
+
+			queue.AddStrip(stripVertices, ts->m_faces.size(), StartsCW(ts));
+		}
+		queue.Build(meshInfo.NumVertices());
+
+		queue.Remove(firstIndex);
+		UpdateCacheStrip(&vcache, tempStrips2[firstIndex], &queue);
 		outStrips.emplace_back(tempStrips2[firstIndex]);
 		
 		tempStrips2[firstIndex]->visited = true;
 		
 		bool bWantsCW = (tempStrips2[firstIndex]->m_faces.size() % 2) == 0;
 		
-		float bestNumHits = -1.0f;
-
-		//this n^2 algo is what slows down stripification so much....
-		// needs to be improved
 		while(1)
 		{
-			bestNumHits = -1.0f;
-			
-			//find best strip to add next, given the current cache
-			for(std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(tempStrips2.size()); i++)
+			//every few hundred strips, see whether to go on
+			if( ((outStrips.size() % PROGRESS_STRIPS) == 0) &&
+				!ReportProgress(StripifyPhase::SP_SPLIT_UP_STRIPS, outStrips.size(), tempStrips2.size()) )
 			{
-				if(tempStrips2[i]->visited)
-					continue;
-
-				numHits = CalcNumHitsStrip(vcache, tempStrips2[i]);
-				if(numHits > bestNumHits)
-				{
-					bestNumHits = numHits;
-					bestIndex = i;
-				}
-				else if(numHits >= bestNumHits)
-				{
-					//check previous strip to see if this one requires it to switch polarity
-					NvStripInfo *strip = tempStrips2[i];
-					size_t nStripFaceCount = strip->m_faces.size();
-					
-					NvFaceInfo tFirstFace(strip->m_faces[0]->m_v0, strip->m_faces[0]->m_v1, strip->m_faces[0]->m_v2);
-					
-					// If there is a second face, reorder vertices such that the
-					// unique vertex is first
-					if (nStripFaceCount > 1)
-					{
-						int nUnique = NvStripifier::GetUniqueVertexInB(strip->m_faces[1], &tFirstFace);
-						if (nUnique == tFirstFace.m_v1)
-						{
-							std::swap(tFirstFace.m_v0, tFirstFace.m_v1);
-						}
-						else if (nUnique == tFirstFace.m_v2)
-						{
-							std::swap(tFirstFace.m_v0, tFirstFace.m_v2);
-						}
-						
-						// If there is a third face, reorder vertices such that the
-						// shared vertex is last
-						if (nStripFaceCount > 2)
-						{
-// EPIC NOTE: No degeneracy check here like in CreateStrips???
-							int nShared0, nShared1;
-							GetSharedVertices(strip->m_faces[2], &tFirstFace, &nShared0, &nShared1);
-							if ( (nShared0 == tFirstFace.m_v1) && (nShared1 == -1) )
-							{
-								std::swap(tFirstFace.m_v1, tFirstFace.m_v2);
-							}
-						}
-					}
-						
-					// Check CW/CCW ordering
-					if (bWantsCW == IsCW(strip->m_faces[0], tFirstFace.m_v0, tFirstFace.m_v1))
-					{
-						//I like this one!
-						bestIndex = i;
-					}
-				}
+				outStrips.clear();
+				break;
 			}
+
+			//find best strip to add next, given the current cache.
+			// of the ones with the most hits, we'd like one which doesn't require the
+			// previous strip to switch polarity, unless each strip restarts anyway
+			size_t bestIndex = bRestartStrips ? queue.Next() : queue.Next(bWantsCW);
 		
-			if(bestNumHits == -1.0f)
+			if(bestIndex == StripOrderQueue::NONE)
 				break;
 
+			queue.Remove(bestIndex);
 			tempStrips2[bestIndex]->visited = true;
-			UpdateCacheStrip(vcache, tempStrips2[bestIndex]);
+			UpdateCacheStrip(&vcache, tempStrips2[bestIndex], &queue);
 			outStrips.emplace_back(tempStrips2[bestIndex]);
 			bWantsCW = (tempStrips2[bestIndex]->m_faces.size() % 2 == 0) ? bWantsCW : !bWantsCW;
 		}
-		
-		delete vcache;	
 	}
 }
 
@@ -1430,38 +1512,109 @@ void NvStripifier::SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripIn
 ///////////////////////////////////////////////////////////////////////////////////////////
 // UpdateCacheStrip()
 //
-// Updates the input vertex cache with this strip's vertices
+// Updates the input vertex cache with this strip's vertices, telling queue (if any) about
+//  every vertex going in and out
 //
-void NvStripifier::UpdateCacheStrip(VertexCache* vcache, NvStripInfo* strip)
+void NvStripifier::UpdateCacheStrip(VertexCache* vcache, NvStripInfo* strip, StripOrderQueue* queue)
 {
+	auto addVertex = [vcache, queue](int v) {
+		NV_NVTS_PROFILE_COUNT(cacheTests, 1);
+		if(vcache->InCache(v))
+		{
+			vcache->Touch(v);
+			return;
+		}
+
+		int removed = vcache->AddEntry(v);
+		if(queue != nullptr)
+		{
+			queue->VertexEntered(v);
+			if(removed >= 0)
+				queue->VertexLeft(removed);
+		}
+	};
+
 	for(auto &f : strip->m_faces)
 	{
-		if(!vcache->InCache(f->m_v0))
-			vcache->AddEntry(f->m_v0);
-		
-		if(!vcache->InCache(f->m_v1))
-			vcache->AddEntry(f->m_v1);
+		addVertex(f->m_v0);
+		addVertex(f->m_v1);
+		addVertex(f->m_v2);
+	}
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// StartsCW()
+//
+// Returns true if the strip's first face, reordered like CreateStrips() does, is CW
+//
+bool NvStripifier::StartsCW(NvStripInfo* strip)
+{
+	size_t nStripFaceCount = strip->m_faces.size();
+	if(nStripFaceCount == 0)
+		return false;
+	
+	NvFaceInfo tFirstFace(strip->m_faces[0]->m_v0, strip->m_faces[0]->m_v1, strip->m_faces[0]->m_v2);
+	
+	// If there is a second face, reorder vertices such that the
+	// unique vertex is first
+	if (nStripFaceCount > 1)
+	{
+		int nUnique = NvStripifier::GetUniqueVertexInB(strip->m_faces[1], &tFirstFace);
+		if (nUnique == tFirstFace.m_v1)
+		{
+			std::swap(tFirstFace.m_v0, tFirstFace.m_v1);
+		}
+		else if (nUnique == tFirstFace.m_v2)
+		{
+			std::swap(tFirstFace.m_v0, tFirstFace.m_v2);
+		}
 		
-		if(!vcache->InCache(f->m_v2))
-			vcache->AddEntry(f->m_v2);
+		// If there is a third face, reorder vertices such that the
+		// shared vertex is last
+		if (nStripFaceCount > 2)
+		{
+// EPIC NOTE: No degeneracy check here like in CreateStrips???
+			int nShared0, nShared1;
+			GetSharedVertices(strip->m_faces[2], &tFirstFace, &nShared0, &nShared1);
+			if ( (nShared0 == tFirstFace.m_v1) && (nShared1 == -1) )
+			{
+				std::swap(tFirstFace.m_v1, tFirstFace.m_v2);
+			}
+		}
 	}
+	
+	return IsCW(strip->m_faces[0], tFirstFace.m_v0, tFirstFace.m_v1);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 // UpdateCacheFace()
 //
-// Updates the input vertex cache with this face's vertices
+// Updates the input vertex cache with this face's vertices, telling queue (if any) about
+//  every vertex going in and out
 //
-void NvStripifier::UpdateCacheFace(VertexCache* vcache, NvFaceInfo* face)
+void NvStripifier::UpdateCacheFace(VertexCache* vcache, NvFaceInfo* face, StripOrderQueue* queue)
 {
-	if(!vcache->InCache(face->m_v0))
-		vcache->AddEntry(face->m_v0);
-		
-	if(!vcache->InCache(face->m_v1))
-		vcache->AddEntry(face->m_v1);
-		
-	if(!vcache->InCache(face->m_v2))
-		vcache->AddEntry(face->m_v2);
+	auto addVertex = [vcache, queue](int v) {
+		NV_NVTS_PROFILE_COUNT(cacheTests, 1);
+		if(vcache->InCache(v))
+		{
+			vcache->Touch(v);
+			return;
+		}
+
+		int removed = vcache->AddEntry(v);
+		if(queue != nullptr)
+		{
+			queue->VertexEntered(v);
+			if(removed >= 0)
+				queue->VertexLeft(removed);
+		}
+	};
+
+	addVertex(face->m_v0);
+	addVertex(face->m_v1);
+	addVertex(face->m_v2);
 }
 
 
@@ -1474,6 +1627,7 @@ float NvStripifier::CalcNumHitsStrip(VertexCache* vcache, NvStripInfo* strip)
 {
 	std::ptrdiff_t numHits = 0;
 	std::ptrdiff_t numFaces = 0;
+	NV_NVTS_PROFILE_COUNT(cacheTests, strip->m_faces.size() * 3);
 	
 	for(auto &f : strip->m_faces)
 	{
@@ -1501,6 +1655,7 @@ float NvStripifier::CalcNumHitsStrip(VertexCache* vcache, NvStripInfo* strip)
 int NvStripifier::CalcNumHitsFace(VertexCache* vcache, NvFaceInfo* face)
 {
 	int numHits = 0;
+	NV_NVTS_PROFILE_COUNT(cacheTests, 3);
 
 	if(vcache->InCache(face->m_v0))
 		numHits++;
@@ -1520,21 +1675,21 @@ int NvStripifier::CalcNumHitsFace(VertexCache* vcache, NvFaceInfo* face)
 //
 // Returns the number of neighbors that this face has
 //
-int NvStripifier::NumNeighbors(const NvFaceInfo* face, NvEdgeInfoVec& edgeInfoVec)
+int NvStripifier::NumNeighbors(const NvFaceInfo* face, NvMeshInfo& meshInfo)
 {
 	int numNeighbors = 0;
 	
-	if(FindOtherFace(edgeInfoVec, face->m_v0, face->m_v1, face) != nullptr)
+	if(FindOtherFace(meshInfo, face->m_v0, face->m_v1, face) != nullptr)
 	{
 		numNeighbors++;
 	}
 	
-	if(FindOtherFace(edgeInfoVec, face->m_v1, face->m_v2, face) != nullptr)
+	if(FindOtherFace(meshInfo, face->m_v1, face->m_v2, face) != nullptr)
 	{
 		numNeighbors++;
 	}
 	
-	if(FindOtherFace(edgeInfoVec, face->m_v2, face->m_v0, face) != nullptr)
+	if(FindOtherFace(meshInfo, face->m_v2, face->m_v0, face) != nullptr)
 	{
 		numNeighbors++;
 	}
@@ -1559,6 +1714,114 @@ float NvStripifier::AvgStripSize(const NvStripInfoVec &strips){
 }
 
 
+///////////////////////////////////////////////////////////////////////////////////////////
+// CostPerFace()
+//
+// What drawing the faces of the input vector of strips would cost, per face: joining
+//  every strip on, the degenerates turning them, and the vertices they use.  Strips are
+//  built next to each other, so each vertex is counted once, as if it stayed in the cache
+//  from one strip to the next
+//
+float NvStripifier::CostPerFace(const NvStripInfoVec &strips){
+	if(costVertexIds.size() < meshInfo.NumVertices())
+		costVertexIds.resize(meshInfo.NumVertices(), 0);
+
+	if(costId == std::numeric_limits<unsigned int>::max())
+	{
+		std::fill(std::begin(costVertexIds), std::end(costVertexIds), 0);
+		costId = 0;
+	}
+	++costId;
+
+	size_t numVertices = 0;
+	auto countVertex = [this, &numVertices](int v) {
+		if(costVertexIds[v] != costId)
+		{
+			costVertexIds[v] = costId;
+			++numVertices;
+		}
+	};
+
+	float cost = 0.0f;
+	for (auto *strip : strips){
+		cost += costs.joinCost + costs.degenerateCost * static_cast<float>(strip->m_numDegenerates);
+		for (auto *f : strip->m_faces)
+		{
+			countVertex(f->m_v0);
+			countVertex(f->m_v1);
+			countVertex(f->m_v2);
+		}
+	}
+	cost += costs.vertexCost * static_cast<float>(numVertices);
+
+	const size_t numFaces = NumRealFaces(strips);
+	return (numFaces != 0) ? (cost / static_cast<float>(numFaces)) : 0.0f;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// NumRealFaces()
+//
+// Counts the faces of the mesh in the input vector of strips, leaving out the degenerates
+//
+size_t NvStripifier::NumRealFaces(const NvStripInfoVec &strips){
+	size_t numFaces = 0;
+	for (auto *strip : strips)
+		numFaces += strip->m_faces.size() - strip->m_numDegenerates;
+	return numFaces;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// GetWorkspace()
+//
+// Returns the workspace of the given thread, making it if this is the first time the thread
+//  runs an experiment.  Only that thread ever touches its workspace, so this needs no locking.
+//
+NvExperimentWorkspace &NvStripifier::GetWorkspace(size_t threadIndex)
+{
+	assert(threadIndex < workspaces.size());
+	if(!workspaces[threadIndex])
+		workspaces[threadIndex] = std::make_unique<NvExperimentWorkspace>(meshInfo.NumFaces());
+
+	return *workspaces[threadIndex];
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// RunExperiment()
+//
+// Builds the first strip of the experiment, and the strips that follow it to see how far we get
+//
+void NvStripifier::RunExperiment(NvMeshInfo &meshInfo, NvExperiment &experiment, NvExperimentWorkspace &workspace)
+{
+	NV_NVTS_PROFILE_THREAD(threadProfile, workspace.m_profile);
+	NV_NVTS_PROFILE_COUNT(experimentsBuilt, 1);
+
+	// the experiment is numbered after its first strip
+	int experimentId = workspace.m_nextStripId;
+
+	// build the first strip of the list
+	NvStripInfo *stripIter = workspace.m_stripPool.New(experiment.m_startInfo, workspace.m_nextStripId++,
+													   experimentId, &workspace);
+	stripIter->Build(meshInfo);
+	experiment.m_strips.emplace_back(stripIter);
+	
+	NvStripStartInfo startInfo(nullptr, nullptr, false);
+	while (FindTraversal(meshInfo, stripIter, startInfo)){
+		
+		// create the new strip info
+		stripIter = workspace.m_stripPool.New(startInfo, workspace.m_nextStripId++, experimentId, &workspace);
+		
+		// build the next strip
+		stripIter->Build(meshInfo);
+		
+		// add it to the list
+		experiment.m_strips.emplace_back(stripIter);
+	}
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // FindAllStrips()
 //
@@ -1569,29 +1832,36 @@ float NvStripifier::AvgStripSize(const NvStripInfoVec &strips){
 //  on to a different area of the mesh.  We try to jump around the mesh some, to ensure that
 //  large open spans of strips get generated.
 //
+// Once the experiments have built more than workBudget faces, we only take one sample a round.
+//
 void NvStripifier::FindAllStrips(NvStripInfoVec &allStrips,
-								 NvFaceInfoVec &allFaceInfos,
-								 NvEdgeInfoVec &allEdgeInfos,
+								 NvMeshInfo &meshInfo,
 								 int numSamples){
 	// the experiments
-	int experimentId = 0;
-	int stripId      = 0;
+	std::vector<NvExperiment> experiments;
+	experiments.reserve(numSamples * 6);
 	bool done        = false;
 
+	// faces committed so far, and built by all experiments so far
+	size_t numCommittedFaces = 0;
+	size_t work              = 0;
+
 	while (!done)
 	{
+		NV_NVTS_PROFILE_COUNT(findAllStripsRounds, 1);
+		NV_NVTS_PROFILE_TIMER(phaseTimer, findAllStripsSetup);
+
 		//
 		// PHASE 1: Set up numSamples * numEdges experiments
 		//
-		NvStripInfoVec *experiments = new NvStripInfoVec [numSamples * 6];
-		int experimentIndex = 0;
+		experiments.clear();
 		std::set   <NvFaceInfo*>  resetPoints;
 		for (int i = 0; i < numSamples; i++)
 		{
 			
 			// Try to find another good reset point.
 			// If there are none to be found, we are done
-			NvFaceInfo *nextFace = FindGoodResetPoint(allFaceInfos, allEdgeInfos);
+			NvFaceInfo *nextFace = FindGoodResetPoint(meshInfo);
 			if (nextFace == nullptr){
 				done = true;
 				break;
@@ -1606,37 +1876,31 @@ void NvStripifier::FindAllStrips(NvStripInfoVec &allStrips,
 			resetPoints.insert(nextFace);
 			
 			// otherwise, we shall now try experiments for starting on the 01,12, and 20 edges
-			assert(nextFace->m_stripId < 0);
+			assert(meshInfo.StripId(nextFace) < 0);
 			
 			// build the strip off of this face's 0-1 edge
-			NvEdgeInfo *edge01 = FindEdgeInfo(allEdgeInfos, nextFace->m_v0, nextFace->m_v1);
-			NvStripInfo *strip01 = new NvStripInfo(NvStripStartInfo(nextFace, edge01, true), stripId++, experimentId++);
-			experiments[experimentIndex++].emplace_back(strip01);
+			NvEdgeInfo *edge01 = FindEdgeInfo(meshInfo, nextFace->m_v0, nextFace->m_v1);
+			experiments.emplace_back(NvStripStartInfo(nextFace, edge01, true));
 			
 			// build the strip off of this face's 1-0 edge
-			NvEdgeInfo *edge10 = FindEdgeInfo(allEdgeInfos, nextFace->m_v0, nextFace->m_v1);
-			NvStripInfo *strip10 = new NvStripInfo(NvStripStartInfo(nextFace, edge10, false), stripId++, experimentId++);
-			experiments[experimentIndex++].emplace_back(strip10);
+			NvEdgeInfo *edge10 = FindEdgeInfo(meshInfo, nextFace->m_v0, nextFace->m_v1);
+			experiments.emplace_back(NvStripStartInfo(nextFace, edge10, false));
 			
 			// build the strip off of this face's 1-2 edge
-			NvEdgeInfo *edge12 = FindEdgeInfo(allEdgeInfos, nextFace->m_v1, nextFace->m_v2);
-			NvStripInfo *strip12 = new NvStripInfo(NvStripStartInfo(nextFace, edge12, true), stripId++, experimentId++);
-			experiments[experimentIndex++].emplace_back(strip12);
+			NvEdgeInfo *edge12 = FindEdgeInfo(meshInfo, nextFace->m_v1, nextFace->m_v2);
+			experiments.emplace_back(NvStripStartInfo(nextFace, edge12, true));
 			
 			// build the strip off of this face's 2-1 edge
-			NvEdgeInfo *edge21 = FindEdgeInfo(allEdgeInfos, nextFace->m_v1, nextFace->m_v2);
-			NvStripInfo *strip21 = new NvStripInfo(NvStripStartInfo(nextFace, edge21, false), stripId++, experimentId++);
-			experiments[experimentIndex++].emplace_back(strip21);
+			NvEdgeInfo *edge21 = FindEdgeInfo(meshInfo, nextFace->m_v1, nextFace->m_v2);
+			experiments.emplace_back(NvStripStartInfo(nextFace, edge21, false));
 			
 			// build the strip off of this face's 2-0 edge
-			NvEdgeInfo *edge20 = FindEdgeInfo(allEdgeInfos, nextFace->m_v2, nextFace->m_v0);
-			NvStripInfo *strip20 = new NvStripInfo(NvStripStartInfo(nextFace, edge20, true), stripId++, experimentId++);
-			experiments[experimentIndex++].emplace_back(strip20);
+			NvEdgeInfo *edge20 = FindEdgeInfo(meshInfo, nextFace->m_v2, nextFace->m_v0);
+			experiments.emplace_back(NvStripStartInfo(nextFace, edge20, true));
 			
 			// build the strip off of this face's 0-2 edge
-			NvEdgeInfo *edge02 = FindEdgeInfo(allEdgeInfos, nextFace->m_v2, nextFace->m_v0);
-			NvStripInfo *strip02 = new NvStripInfo(NvStripStartInfo(nextFace, edge02, false), stripId++, experimentId++);
-			experiments[experimentIndex++].emplace_back(strip02);
+			NvEdgeInfo *edge02 = FindEdgeInfo(meshInfo, nextFace->m_v2, nextFace->m_v0);
+			experiments.emplace_back(NvStripStartInfo(nextFace, edge02, false));
 		}
 		
 		//
@@ -1644,44 +1908,104 @@ void NvStripifier::FindAllStrips(NvStripInfoVec &allStrips,
 		// and really build each of the strips and strips that follow to see how
 		// far we get
 		//
-		int numExperiments = experimentIndex;
-		for (int i = 0; i < numExperiments; i++){
-			
-			// get the strip set
-			
-			// build the first strip of the list
-			experiments[i][0]->Build(allEdgeInfos, allFaceInfos);
-			int experimentId2 = experiments[i][0]->m_experimentId;
-			
-			NvStripInfo *stripIter = experiments[i][0];
-			NvStripStartInfo startInfo(nullptr, nullptr, false);
-			while (FindTraversal(allFaceInfos, allEdgeInfos, stripIter, startInfo)){
-				
-				// create the new strip info
-				stripIter = new NvStripInfo(startInfo, stripId++, experimentId2);
-				
-				// build the next strip
-				stripIter->Build(allEdgeInfos, allFaceInfos);
-				
-				// add it to the list
-				experiments[i].emplace_back(stripIter);
+		// The experiments only read the mesh and keep their marks in the workspace of
+		// the thread running them, so they don't care about each other, and may all run at once.
+		//
+		// If we're stopping at full cover, the first experiment to take all the remaining faces
+		// wins, and the ones after it needn't run.  Those before it always run all the way, so
+		// which one wins doesn't depend on the order the threads get to them.
+		//
+		NV_NVTS_PROFILE_SWITCH(phaseTimer, findAllStripsExperiments);
+		size_t numExperiments = experiments.size();
+		if(numExperiments == 0)
+			break;
+
+		size_t numFacesLeft = NumResetFaces(meshInfo) - numCommittedFaces;
+		std::atomic<size_t> firstFullCover(numExperiments);
+
+		auto runExperiment = [&](size_t i, NvExperimentWorkspace &workspace) {
+			if(bStopAtFullCover && (i > firstFullCover.load(std::memory_order_relaxed)))
+				return;
+
+			//once cancelled, the round is thrown away below
+			if(!ReportProgress(StripifyPhase::SP_FIND_ALL_STRIPS, numCommittedFaces, NumResetFaces(meshInfo)))
+				return;
+
+			RunExperiment(meshInfo, experiments[i], workspace);
+
+			if(bStopAtFullCover && (NumRealFaces(experiments[i].m_strips) == numFacesLeft))
+			{
+				size_t current = firstFullCover.load(std::memory_order_relaxed);
+				while( (i < current) && !firstFullCover.compare_exchange_weak(current, i, std::memory_order_relaxed) )
+					;
+			}
+		};
+
+		if(threadPool != nullptr)
+		{
+			TaskGroup group(*threadPool);
+			for (size_t i = 0; i < numExperiments; i++)
+			{
+				group.Run([this, &runExperiment, i] {
+					runExperiment(i, GetWorkspace(threadPool->CurrentThreadIndex()));
+				});
+			}
+			group.Wait();
+		}
+		else
+		{
+			NvExperimentWorkspace &workspace = GetWorkspace(0);
+			for (size_t i = 0; i < numExperiments; i++)
+				runExperiment(i, workspace);
+		}
+
+		//none of them is committed once cancelled
+		if(bCancelled.load())
+		{
+			for (auto &e : experiments)
+			{
+				for (auto *strip : e.m_strips)
+					strip->m_workspace->m_stripPool.Delete(strip);
 			}
+			break;
 		}
+
+		for (auto &e : experiments)
+			work += NumRealFaces(e.m_strips);
+
+		// out of budget, go as quick as we can from here on
+		if( (workBudget != 0) && (work >= workBudget) )
+			numSamples = 1;
 		
 		//
-		// Phase 3: Find the experiment that has the most promise
+		// Phase 3: Find the experiment that has the most promise, if none took everything
 		//
-		int bestIndex = 0;
+		NV_NVTS_PROFILE_SWITCH(phaseTimer, findAllStripsSelect);
+		size_t bestIndex = 0;
 		double bestValue = 0;
-		for (int i = 0; i < numExperiments; i++)
+		bool bFullCover  = (firstFullCover.load() < numExperiments);
+		if (bFullCover)
+			bestIndex = firstFullCover.load();
+
+		for (size_t i = 0; !bFullCover && (i < numExperiments); i++)
 		{
-			constexpr float avgStripSizeWeight = 1.0f;
-			constexpr float numStripsWeight    = 0.0f;
-			float avgStripSize = AvgStripSize(experiments[i]);
-			float numStrips    = (float) experiments[i].size();
-			float value        = avgStripSize * avgStripSizeWeight + (numStrips * numStripsWeight);
+			float value;
+			if(costs.bEnabled)
+			{
+				//with a hardware profile, the cheapest to draw per face wins
+				value = -CostPerFace(experiments[i].m_strips);
+			}
+			else
+			{
+				constexpr float avgStripSizeWeight = 1.0f;
+				constexpr float numStripsWeight    = 0.0f;
+				float avgStripSize = AvgStripSize(experiments[i].m_strips);
+				float numStrips    = (float) experiments[i].m_strips.size();
+				value              = avgStripSize * avgStripSizeWeight + (numStrips * numStripsWeight);
+			}
 
-			if (value > bestValue)
+			//costs are negative, so the first experiment has to be taken whatever it is
+			if ( (value > bestValue) || (costs.bEnabled && (i == 0)) )
 			{
 				bestValue = value;
 				bestIndex = i;
@@ -1691,32 +2015,51 @@ void NvStripifier::FindAllStrips(NvStripInfoVec &allStrips,
 		//
 		// Phase 4: commit the best experiment of the bunch
 		//
-		CommitStrips(allStrips, experiments[bestIndex]);
+		NV_NVTS_PROFILE_SWITCH(phaseTimer, findAllStripsCommit);
+		CommitStrips(allStrips, experiments[bestIndex].m_strips);
+		numCommittedFaces += NumRealFaces(experiments[bestIndex].m_strips);
 		
-		// and destroy all of the others
-		for (int i = 0; i < numExperiments; i++)
+		// and destroy all of the others, their degenerate faces go when the workspaces do
+		for (size_t i = 0; i < numExperiments; i++)
 		{
 			if (i != bestIndex)
 			{
-				size_t numStrips = experiments[i].size();
-				for (size_t j = 0; j < numStrips; j++)
-				{
-// START EPIC MOD: Fix memory leak
-					for ( int iDegenerate = 0; iDegenerate < experiments[ i ][ j ]->m_numDegenerates; ++iDegenerate )
-					{
-						delete experiments[ i ][ j ]->m_Degenerates[ iDegenerate ];
-					}
-// END EPIC MOD: Fix memory leak
-
-					delete experiments[i][j];
-				}
+				for (auto *strip : experiments[i].m_strips)
+					strip->m_workspace->m_stripPool.Delete(strip);
 			}
 		}
-		
-		// delete the array that we used for all experiments
-		delete [] experiments;
   }
 }
 
+#ifdef NV_NVTS_ENABLE_PROFILING
+///////////////////////////////////////////////////////////////////////////////////////////
+// GetProfile()
+//
+// The profile of the last Stripify() and CreateStrips(), with those of all the threads
+//  which ran experiments added in
+//
+StripifyProfile NvStripifier::GetProfile() const
+{
+	StripifyProfile result = profile;
+	for(auto &workspace : workspaces)
+	{
+		if(workspace)
+			MergeProfile(result, workspace->m_profile);
+	}
+
+	return result;
+}
+#endif
+
+//the index widths we stripify from and into
+template void NvStripifier::Stripify<uint16_t>(const uint16_t*, const size_t, const int, const size_t, const size_t,
+											   NvStripInfoVec&, NvFaceInfoVec&);
+template void NvStripifier::Stripify<uint32_t>(const uint32_t*, const size_t, const int, const size_t, const size_t,
+											   NvStripInfoVec&, NvFaceInfoVec&);
+template void NvStripifier::CreateStrips<uint16_t>(const NvStripInfoVec&, std::vector<uint16_t>&, const bool, size_t&);
+template void NvStripifier::CreateStrips<uint32_t>(const NvStripInfoVec&, std::vector<uint32_t>&, const bool, size_t&);
+template void NvStripifier::BuildStripifyInfo<uint16_t>(NvMeshInfo&, const uint16_t*, const size_t, const size_t);
+template void NvStripifier::BuildStripifyInfo<uint32_t>(NvMeshInfo&, const uint32_t*, const size_t, const size_t);
+
 }  // namespace nv::tristrip::internal
 
@@ -1,10 +1,20 @@
 #ifndef NV_TRISTRIP_OBJECTS_H
 #define NV_TRISTRIP_OBJECTS_H
 
+#include "EdgeHashTable.h"
+#include "FaceHashTable.h"
+#include "ObjectPool.h"
+#include "Profiler.h"
 #include "VertexCache.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <list>
 
@@ -29,21 +39,22 @@ struct MyFace {
 };
 
 
+// faces and edges refer to each other by their 32 bit index in the arrays of NvMeshInfo
+using NvIndex = std::uint32_t;
+
+constexpr inline NvIndex NV_INVALID_INDEX{0xFFFFFFFF};
+
 class NvFaceInfo {
 public:
 	// vertex indices
-	NvFaceInfo(int v0, int v1, int v2){
+	NvFaceInfo(int v0, int v1, int v2, NvIndex index = NV_INVALID_INDEX){
 		m_v0 = v0; m_v1 = v1; m_v2 = v2;
-		m_stripId      = -1;
-		m_testStripId  = -1;
-		m_experimentId = -1;
+		m_index = index;
 	}
 	
 	// data members are left public
-	int   m_v0, m_v1, m_v2;
-	int   m_stripId;      // real strip Id
-	int   m_testStripId;  // strip Id in an experiment
-	int   m_experimentId; // in what experiment was it given an experiment Id?
+	int     m_v0, m_v1, m_v2;
+	NvIndex m_index;  // index into the face arrays of the mesh, NV_INVALID_INDEX if not in the mesh
 };
 
 // nice and dumb edge class that points knows its
@@ -51,30 +62,189 @@ public:
 // the lesser of the indices
 class NvEdgeInfo {
 public:
-	// constructor puts 1 ref on us
 	NvEdgeInfo (int v0, int v1){
 		m_v0       = v0;
 		m_v1       = v1;
-		m_face0    = nullptr;
-		m_face1    = nullptr;
-		m_nextV0   = nullptr;
-		m_nextV1   = nullptr;
-		
-		// we will appear in 2 lists.  this is a good
-		// way to make sure we delete it the second time
-		// we hit it in the edge infos
-		m_refCount = 2;    
-		
+		m_face0    = NV_INVALID_INDEX;
+		m_face1    = NV_INVALID_INDEX;
+		m_nextV0   = NV_INVALID_INDEX;
+		m_nextV1   = NV_INVALID_INDEX;
 	}
 	
-	// ref and unref
-	void Unref () { if (--m_refCount == 0) delete this; }
-	
-	// data members are left public
-	unsigned int m_refCount;
-	NvFaceInfo  *m_face0, *m_face1;
+	// data members are left public, the faces and next edges are indices into NvMeshInfo
 	int          m_v0, m_v1;
-	NvEdgeInfo  *m_nextV0, *m_nextV1;
+	NvIndex      m_face0, m_face1;
+	NvIndex      m_nextV0, m_nextV1;
+};
+
+// Everything we know about the mesh being stripified.
+//
+// The faces and edges each live in one contiguous array, and refer to each other by
+// index instead of by pointer.  The strip ids of the faces are kept in arrays of their
+// own, so the scans looking for faces which aren't in a strip yet only touch those.
+// Every vertex heads a linked list of the edges using it, which is how we walk the
+// edges around a vertex.  Finding the edge between two given vertices goes through
+// a hash table instead, so it costs the same no matter how many edges a vertex has.
+class NvMeshInfo {
+public:
+	// throws away everything, and makes room for vertices 0 to numVertices-1
+	void Reset(size_t numVertices, size_t numFaces)
+	{
+		m_faces.clear();
+		m_faces.reserve(numFaces);
+		m_stripIds.clear();
+		m_stripIds.reserve(numFaces);
+
+		// about as many edges as a closed mesh has
+		size_t numEdges = numFaces * 3 / 2;
+		m_edges.clear();
+		m_edges.reserve(numEdges);
+		m_edgeHeads.assign(numVertices, NV_INVALID_INDEX);
+		m_edgeHash.Reset(numEdges);
+
+		// only non-manifold meshes have any of these
+		m_offEdgeFaces.Reset(0);
+	}
+
+	size_t NumFaces() const { return m_faces.size(); }
+	size_t NumVertices() const { return m_edgeHeads.size(); }
+
+	// makes room for vertices up to numVertices-1, keeping everything
+	void GrowVertices(size_t numVertices)
+	{
+		if(numVertices > m_edgeHeads.size())
+			m_edgeHeads.resize(numVertices, NV_INVALID_INDEX);
+	}
+
+	// adding faces past the capacity moves all of them, and pointers to them go bad
+	size_t FaceCapacity() const { return m_faces.capacity(); }
+	void ReserveFaces(size_t numFaces)
+	{
+		m_faces.reserve(numFaces);
+		m_stripIds.reserve(numFaces);
+	}
+
+	NvFaceInfo *Face(NvIndex i) { return (i != NV_INVALID_INDEX) ? &m_faces[i] : nullptr; }
+	NvEdgeInfo *Edge(NvIndex i) { return (i != NV_INVALID_INDEX) ? &m_edges[i] : nullptr; }
+
+	// adds a face which isn't in any strip yet
+	NvIndex AddFace(int v0, int v1, int v2)
+	{
+		NvIndex index = static_cast<NvIndex>(m_faces.size());
+		m_faces.emplace_back(v0, v1, v2, index);
+		m_stripIds.emplace_back(-1);
+		return index;
+	}
+
+	// takes back the face most recently added
+	void RemoveLastFace()
+	{
+		m_faces.pop_back();
+		m_stripIds.pop_back();
+	}
+
+	// puts a face added with AddFace() on the edges between its vertices, making the ones
+	//  which aren't there yet.  It takes a free side of each edge, and is left off the ones
+	//  which already have two faces.  Returns false if it went on none at all
+	bool LinkFace(NvIndex face)
+	{
+		int vertices[3] = {m_faces[face].m_v0, m_faces[face].m_v1, m_faces[face].m_v2};
+
+		bool bLinked = false;
+		for(int i = 0; i < 3; i++)
+		{
+			int v0 = vertices[i];
+			int v1 = vertices[(i + 1) % 3];
+
+			NvIndex edge = FindEdgeIndex(v0, v1);
+			if(edge == NV_INVALID_INDEX)
+				edge = AddEdge(v0, v1);
+
+			NvEdgeInfo &edgeInfo = m_edges[edge];
+			if(edgeInfo.m_face0 == NV_INVALID_INDEX)
+				edgeInfo.m_face0 = face;
+			else if(edgeInfo.m_face1 == NV_INVALID_INDEX)
+				edgeInfo.m_face1 = face;
+			else
+				continue;
+
+			bLinked = true;
+		}
+
+		return bLinked;
+	}
+
+	// takes a face off the edges it is on, the edges themselves stay
+	void UnlinkFace(NvIndex face)
+	{
+		const NvFaceInfo &faceInfo = m_faces[face];
+		int vertices[3] = {faceInfo.m_v0, faceInfo.m_v1, faceInfo.m_v2};
+
+		for(int i = 0; i < 3; i++)
+		{
+			NvEdgeInfo *edgeInfo = FindEdge(vertices[i], vertices[(i + 1) % 3]);
+			if(edgeInfo == nullptr)
+				continue;
+
+			if(edgeInfo->m_face0 == face)
+				edgeInfo->m_face0 = NV_INVALID_INDEX;
+			if(edgeInfo->m_face1 == face)
+				edgeInfo->m_face1 = NV_INVALID_INDEX;
+		}
+	}
+
+	// the faces which came when their v0-v1 edge already had two, so aren't on it
+	void AddOffEdgeFace(const NvFaceInfo *faceInfo) { m_offEdgeFaces.Insert(faceInfo->m_v0, faceInfo->m_v1, faceInfo->m_v2); }
+	bool IsOffEdgeFace(int v0, int v1, int v2) const { return m_offEdgeFaces.Contains(v0, v1, v2); }
+
+	// adds an edge at the front of the lists of both of its vertices
+	NvIndex AddEdge(int v0, int v1)
+	{
+		NvIndex index = static_cast<NvIndex>(m_edges.size());
+		m_edges.emplace_back(v0, v1);
+
+		NvEdgeInfo &edgeInfo = m_edges.back();
+		edgeInfo.m_nextV0 = m_edgeHeads[v0];
+		edgeInfo.m_nextV1 = m_edgeHeads[v1];
+		m_edgeHeads[v0] = index;
+		m_edgeHeads[v1] = index;
+
+		m_edgeHash.Insert(v0, v1, index);
+		return index;
+	}
+
+	// the edge between v0 and v1, in either direction
+	NvIndex FindEdgeIndex(int v0, int v1) const
+	{
+		const NvIndex* index = m_edgeHash.Find(v0, v1);
+		return (index != nullptr) ? *index : NV_INVALID_INDEX;
+	}
+
+	NvEdgeInfo *FindEdge(int v0, int v1) { return Edge(FindEdgeIndex(v0, v1)); }
+
+	// first edge in the linked list of edges using v
+	NvEdgeInfo *FirstEdge(int v) { return Edge(m_edgeHeads[v]); }
+
+	// edge after edgeInfo in the linked list of edges using v
+	NvEdgeInfo *NextEdge(const NvEdgeInfo *edgeInfo, int v)
+	{
+		return Edge(edgeInfo->m_v0 == v ? edgeInfo->m_nextV0 : edgeInfo->m_nextV1);
+	}
+
+	// the id of the committed strip each face is in, the marks of the experiments
+	// are kept by NvExperimentWorkspace
+	int &StripId(const NvFaceInfo *faceInfo) { return m_stripIds[faceInfo->m_index]; }
+
+	int StripId(NvIndex i) const { return m_stripIds[i]; }
+
+private:
+	std::vector<NvFaceInfo>  m_faces;
+	std::vector<int>         m_stripIds;      // real strip Id
+
+	std::vector<NvEdgeInfo>  m_edges;
+	std::vector<NvIndex>     m_edgeHeads;
+	EdgeHashTable<NvIndex>   m_edgeHash;
+	FaceHashTable            m_offEdgeFaces;
 };
 
 
@@ -96,9 +266,20 @@ public:
 
 
 using NvFaceInfoVec = std::vector<NvFaceInfo*>;
+using NvFaceInfoPool = ObjectPool<NvFaceInfo>;
 using NvFaceInfoList = std::list<NvFaceInfo*>;
 using NvStripList = std::list<NvFaceInfoVec*>;
-using NvEdgeInfoVec = std::vector<NvEdgeInfo*>;
+
+//ends each strip in the indices from NvStripifier::CreateStrips(), like a primitive restart index
+template<typename IndexT>
+constexpr inline IndexT STRIP_RESTART_INDEX{static_cast<IndexT>(~IndexT{0})};
+
+//x, y, z of vertex v, in positions laid out like the public functions take them, each
+// vertex positionStride bytes after the last
+inline const float* VertexPosition(const float* positions, size_t positionStride, size_t v)
+{
+	return reinterpret_cast<const float*>(reinterpret_cast<const unsigned char*>(positions) + v * positionStride);
+}
 
 using WordVec = std::vector<unsigned short>;
 using UIntVec = std::vector<unsigned int>;
@@ -106,15 +287,21 @@ using IntVec = std::vector<int>;
 using MyVertexVec = std::vector<MyVertex>;
 using MyFaceVec = std::vector<MyFace>;
 
+class NvExperimentWorkspace;
+class StripOrderQueue;
+class ThreadPool;
+
 // This is a summary of a strip that has been built
 class NvStripInfo {
 public:
 	// A little information about the creation of the triangle strips
-	NvStripInfo(const NvStripStartInfo &startInfo, int stripId, int experimentId = -1) :
+	NvStripInfo(const NvStripStartInfo &startInfo, int stripId, int experimentId = -1,
+				NvExperimentWorkspace *workspace = nullptr) :
 	  m_startInfo(startInfo)
 	{
 		m_stripId      = stripId;
 		m_experimentId = experimentId;
+		m_workspace    = workspace;
 		visited = false;
 		m_numDegenerates = 0;
 	}
@@ -122,28 +309,32 @@ public:
 	// This is an experiment if the experiment id is >= 0
 	inline bool IsExperiment () const { return m_experimentId >= 0; }
 	  
-	inline bool IsInStrip (const NvFaceInfo *faceInfo) const 
+	inline bool IsInStrip (NvMeshInfo &meshInfo, const NvFaceInfo *faceInfo) const 
 	{
 		if(faceInfo == nullptr)
 			return false;
 		  
-		return (m_experimentId >= 0 ? faceInfo->m_testStripId == m_stripId : faceInfo->m_stripId == m_stripId);
+		assert(faceInfo->m_index != NV_INVALID_INDEX);
+		return (m_experimentId >= 0 ? TestStripId(faceInfo) == m_stripId : meshInfo.StripId(faceInfo) == m_stripId);
 	}
 	  
-	bool SharesEdge(const NvFaceInfo* faceInfo, NvEdgeInfoVec &edgeInfos) const;
+	bool SharesEdge(const NvFaceInfo* faceInfo, NvMeshInfo &meshInfo) const;
 	  
 	// take the given forward and backward strips and combine them together
 	void Combine(const NvFaceInfoVec &forward, const NvFaceInfoVec &backward);
 	  
-	//returns true if the face is "unique", i.e. has a vertex which doesn't exist in the faceVec
-	bool Unique(const NvFaceInfoVec& faceVec, NvFaceInfo* face) const;
+	//returns true if the face is "unique", i.e. has a vertex which isn't in the strip being built
+	bool Unique(const NvFaceInfo* face) const;
+
+	//puts the vertices of the face in the strip being built, for Unique()
+	void AddVertices(const NvFaceInfo* face);
 	  
 	// mark the triangle as taken by this strip
-	bool IsMarked    (NvFaceInfo *faceInfo) const;
-	void MarkTriangle(NvFaceInfo *faceInfo);
+	bool IsMarked    (NvMeshInfo &meshInfo, NvFaceInfo *faceInfo) const;
+	void MarkTriangle(NvMeshInfo &meshInfo, NvFaceInfo *faceInfo);
 	  
-	// build the strip
-	void Build(NvEdgeInfoVec &edgeInfos, NvFaceInfoVec &faceInfos);
+	// build the strip, any degenerate faces it needs come out of our workspace
+	void Build(NvMeshInfo &meshInfo);
 	  
 	// public data members
 	NvStripStartInfo m_startInfo;
@@ -151,17 +342,93 @@ public:
 	int              m_stripId;
 	int              m_experimentId;
 	  
+	// where an experiment keeps its marks, and where the strip came from
+	NvExperimentWorkspace *m_workspace;
+
 	bool visited;
 
 	int m_numDegenerates;
 
-// START EPIC MOD: Fix memory leak
-	NvFaceInfoVec m_Degenerates;
-// END EPIC MOD: Fix memory leak
+private:
+	inline int &TestStripId(const NvFaceInfo *faceInfo) const;
 };
 
 using NvStripInfoVec = std::vector<NvStripInfo*>;
+using NvStripInfoPool = ObjectPool<NvStripInfo>;
+
+
+// Everything a thread needs to run experiments without getting in the way of the others.
+//
+// An experiment only marks the faces it takes with the id of its strip.  Strip ids are
+// handed out in order, and the experiments sharing a workspace run one after the other,
+// so an experiment is numbered after its first strip, and the faces it took are exactly
+// the ones marked with an id at least that big.  Marks left by earlier experiments are
+// then harmless, and never need to be cleared.
+class NvExperimentWorkspace {
+public:
+	explicit NvExperimentWorkspace(size_t numFaces) : m_testStripIds(numFaces, -1), m_nextStripId(0), m_buildId(0) {}
+
+	int &TestStripId(const NvFaceInfo *faceInfo) { return m_testStripIds[faceInfo->m_index]; }
+
+	// starts a new NvStripInfo::Build(), with every vertex of the mesh out of its strip
+	void BeginBuild(size_t numVertices);
+
+	std::vector<int> m_testStripIds;
+	int              m_nextStripId;
 
+	//per vertex, the last build here which put it in its strip, so Unique() needn't look
+	// through the faces of the strip
+	std::vector<unsigned int> m_vertexBuildIds;
+	unsigned int              m_buildId;
+
+	//the strips and degenerate faces of the experiments run here
+	NvStripInfoPool  m_stripPool;
+	NvFaceInfoPool   m_facePool;
+
+#ifdef NV_NVTS_ENABLE_PROFILING
+	//what the experiments run here counted, see Profiler.h
+	StripifyProfile  m_profile;
+#endif
+};
+
+inline int &NvStripInfo::TestStripId(const NvFaceInfo *faceInfo) const
+{
+	assert(m_workspace != nullptr);
+	return m_workspace->TestStripId(faceInfo);
+}
+
+
+// One experiment, a place to start a strip and all the strips we could build following on from it
+class NvExperiment {
+public:
+	explicit NvExperiment(const NvStripStartInfo &startInfo) : m_startInfo(startInfo) {}
+
+	NvStripStartInfo m_startInfo;
+	NvStripInfoVec   m_strips;
+};
+
+
+//how long the phases of the last Stripify() and CreateStrips() took, in seconds
+struct NvPhaseTimes
+{
+	double buildStripifyInfo        = 0.0;
+	double findAllStrips            = 0.0;
+	double splitUpStripsAndOptimize = 0.0;
+	double createStrips             = 0.0;
+};
+
+//what the stripifier weighs its choices by when tuning for a HardwareProfile, all in the
+// time it takes to transform a vertex
+struct NvStripCosts
+{
+	bool  bEnabled       = false;  // without, experiments are scored by their average strip length
+	float vertexCost     = 1.0f;
+	float degenerateCost = 0.0f;   // an index in a strip which only makes degenerate triangles
+	float joinCost       = 0.0f;   // a strip following another, with degenerates, a restart or a draw call
+};
+
+//the costs of the profile in the options, for the way they join strips
+NvStripCosts StripCostsFor(const StripifyOptions& options);
 
 //The actual stripifier
 class NvStripifier {
@@ -171,24 +438,101 @@ public:
 	NvStripifier();
 	~NvStripifier();
 	
-	//the target vertex cache size, the structure to place the strips in, and the input indices
-	void Stripify(const UIntVec &in_indices, const int in_cacheSize, const size_t in_minStripLength, 
+	//the target vertex cache size, the structure to place the strips in, and the input indices,
+	// which are only read during the call.  IndexT is uint16_t or uint32_t
+	template<typename IndexT>
+	void Stripify(const IndexT* in_indices, const size_t in_numIndices, const int in_cacheSize, const size_t in_minStripLength, 
 				  const size_t maxIndex, NvStripInfoVec &allStrips, NvFaceInfoVec &allFaces);
-	void CreateStrips(const NvStripInfoVec& allStrips, IntVec& stripIndices, const bool bStitchStrips, size_t& numSeparateStrips);
+	
+	//runs the experiments on the given pool instead of the calling thread, nullptr goes back to that
+	void SetThreadPool(ThreadPool* pool) { threadPool = pool; }
+
+	//how the simulated vertex cache behaves while ordering strips and faces for it
+	void SetCachePolicy(CachePolicy policy) { cachePolicy = policy; }
+
+	//whether the strips will be joined by restart indices, so their winding doesn't matter
+	// when ordering them
+	void SetRestartStrips(bool in_bRestartStrips) { bRestartStrips = in_bRestartStrips; }
+
+	//what to pick experiments and cut strips up by, see NvStripCosts
+	void SetCosts(const NvStripCosts& in_costs) { costs = in_costs; }
+
+	//who to tell how far along Stripify() is, see progressCallback in StripifyOptions,
+	// nullptr for nobody
+	void SetProgress(bool (*in_callback)(const StripifyProgress&, void*), void* in_userData)
+	{
+		progressCallback = in_callback;
+		progressUserData = in_userData;
+	}
+
+	//whether the progress callback cancelled the last Stripify(), which hands back no strips then
+	bool Cancelled() const { return bCancelled.load(); }
+
+	//only start strips on these faces, instead of on any face of the mesh, nullptr goes back
+	// to that.  Strips still grow into any face which isn't in one yet
+	void SetResetFaces(const std::vector<NvIndex>* faces) { resetFaces = faces; }
+
+	//how many experiments to run, see StripifyOptions
+	void SetEffort(int in_numSamples, size_t in_workBudget, bool in_bStopAtFullCover)
+	{
+		numSamples = std::max(1, in_numSamples);
+		workBudget = in_workBudget;
+		bStopAtFullCover = in_bStopAtFullCover;
+	}
+	//separate strips end with STRIP_RESTART_INDEX<IndexT>, so no vertex may use that index then
+	template<typename IndexT>
+	void CreateStrips(const NvStripInfoVec& allStrips, std::vector<IndexT>& stripIndices, const bool bStitchStrips, size_t& numSeparateStrips);
 	
 	static int GetUniqueVertexInB(NvFaceInfo *faceA, NvFaceInfo *faceB);
 	//static int GetSharedVertex(NvFaceInfo *faceA, NvFaceInfo *faceB);
 	static void GetSharedVertices(NvFaceInfo *faceA, NvFaceInfo *faceB, int* vertex0, int* vertex1);
 
 	static bool IsDegenerate(const NvFaceInfo* face);
+
+	const NvPhaseTimes& GetPhaseTimes() const { return phaseTimes; }
+
+#ifdef NV_NVTS_ENABLE_PROFILING
+	StripifyProfile GetProfile() const;
+#endif
 	
 protected:
-	
-	UIntVec indices;
+
+	// the mesh, and everything else we allocate during stripification, live until we do,
+	// so the faces handed back by Stripify() stay valid as long as the stripifier
+	NvMeshInfo      meshInfo;
+	NvStripInfoPool stripPool;
+
+	// one workspace per thread of the pool, made when the thread first runs an experiment
+	ThreadPool* threadPool;
+	std::vector<std::unique_ptr<NvExperimentWorkspace>> workspaces;
+
+	// the faces FindGoodResetPoint() picks from, all of them if nullptr
+	const std::vector<NvIndex>* resetFaces;
+
 	int cacheSize;
+	CachePolicy cachePolicy;
+	bool bRestartStrips;
+	NvStripCosts costs;
 	size_t minStripLength;
+	int numSamples;
+	size_t workBudget;
+	bool bStopAtFullCover;
 	float meshJump;
 	bool bFirstTimeResetPoint;
+
+	// the experiments report too, from whichever thread runs them, one at a time
+	bool (*progressCallback)(const StripifyProgress&, void*);
+	void* progressUserData;
+	std::atomic<bool> bCancelled;
+	std::mutex progressMutex;
+
+	// per vertex, the last experiment CostPerFace() counted it for
+	std::vector<unsigned int> costVertexIds;
+	unsigned int costId;
+	NvPhaseTimes phaseTimes;
+#ifdef NV_NVTS_ENABLE_PROFILING
+	StripifyProfile profile;
+#endif
 	
 	/////////////////////////////////////////////////////////////////////////////////
 	//
@@ -203,33 +547,48 @@ protected:
 	bool IsDegenerate(const unsigned int v0, const unsigned int v1, const unsigned int v2);
 	
 	static int  GetNextIndex(const UIntVec &indices, NvFaceInfo *face);
-	static NvEdgeInfo *FindEdgeInfo(const NvEdgeInfoVec &edgeInfos, int v0, int v1);
-	static NvFaceInfo *FindOtherFace(NvEdgeInfoVec &edgeInfos, int v0, int v1, const NvFaceInfo *faceInfo);
-	NvFaceInfo *FindGoodResetPoint(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos);
+	static NvEdgeInfo *FindEdgeInfo(NvMeshInfo &meshInfo, int v0, int v1);
+	static NvFaceInfo *FindOtherFace(NvMeshInfo &meshInfo, int v0, int v1, const NvFaceInfo *faceInfo);
+	NvFaceInfo *FindGoodResetPoint(NvMeshInfo &meshInfo);
+	size_t NumResetFaces(const NvMeshInfo &meshInfo) const { return (resetFaces != nullptr) ? resetFaces->size() : meshInfo.NumFaces(); }
+	NvIndex ResetFace(size_t i) const { return (resetFaces != nullptr) ? (*resetFaces)[i] : static_cast<NvIndex>(i); }
+	
+	void SetSizes(const int in_cacheSize, const size_t in_minStripLength);
+	//calls the progress callback, if there is one, returns false once it has cancelled
+	bool ReportProgress(StripifyPhase phase, size_t done, size_t total);
+	void StripifyFreeFaces(NvStripInfoVec &outStrips, NvFaceInfoVec &outFaceList);
 	
-	void FindAllStrips(NvStripInfoVec &allStrips, NvFaceInfoVec &allFaceInfos, NvEdgeInfoVec &allEdgeInfos, int numSamples);
-	void SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripInfoVec &outStrips, NvEdgeInfoVec& edgeInfos, NvFaceInfoVec& outFaceList);
+	void FindAllStrips(NvStripInfoVec &allStrips, NvMeshInfo &meshInfo, int numSamples);
+	void RunExperiment(NvMeshInfo &meshInfo, NvExperiment &experiment, NvExperimentWorkspace &workspace);
+	NvExperimentWorkspace &GetWorkspace(size_t threadIndex);
+	void SplitUpStripsAndOptimize(NvStripInfoVec &allStrips, NvStripInfoVec &outStrips, NvMeshInfo& meshInfo, NvFaceInfoVec& outFaceList);
 	void RemoveSmallStrips(NvStripInfoVec& allStrips, NvStripInfoVec& allBigStrips, NvFaceInfoVec& faceList);
 	
-	bool FindTraversal(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos, NvStripInfo *strip, NvStripStartInfo &startInfo);
+	bool FindTraversal(NvMeshInfo &meshInfo, NvStripInfo *strip, NvStripStartInfo &startInfo);
 	
 	void CommitStrips(NvStripInfoVec &allStrips, const NvStripInfoVec &strips);
 	
 	float AvgStripSize(const NvStripInfoVec &strips);
-	std::ptrdiff_t FindStartPoint(const NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos);
+	float CostPerFace(const NvStripInfoVec &strips);
+	static size_t NumRealFaces(const NvStripInfoVec &strips);
+	std::ptrdiff_t FindStartPoint(NvMeshInfo &meshInfo);
 	
-	void UpdateCacheStrip(VertexCache* vcache, NvStripInfo* strip);
-	void UpdateCacheFace(VertexCache* vcache, NvFaceInfo* face);
+	void UpdateCacheStrip(VertexCache* vcache, NvStripInfo* strip, StripOrderQueue* queue = nullptr);
+	bool StartsCW(NvStripInfo* strip);
+	void UpdateCacheFace(VertexCache* vcache, NvFaceInfo* face, StripOrderQueue* queue = nullptr);
 	float CalcNumHitsStrip(VertexCache* vcache, NvStripInfo* strip);
 	int CalcNumHitsFace(VertexCache* vcache, NvFaceInfo* face);
-	int NumNeighbors(const NvFaceInfo* face, NvEdgeInfoVec& edgeInfoVec);
+	int NumNeighbors(const NvFaceInfo* face, NvMeshInfo& meshInfo);
 	
-	void BuildStripifyInfo(NvFaceInfoVec &faceInfos, NvEdgeInfoVec &edgeInfos, const size_t maxIndex);
-	bool AlreadyExists(NvFaceInfo* faceInfo, const NvFaceInfoVec& faceInfos);
+	template<typename IndexT>
+	void BuildStripifyInfo(NvMeshInfo &meshInfo, const IndexT* indices, const size_t numIndices, const size_t maxIndex);
+	static bool AlreadyExists(NvFaceInfo* faceInfo, NvMeshInfo& meshInfo, const NvEdgeInfo* edgeInfo01);
 	
 	// let our strip info classes and the other classes get
 	// to these protected stripificaton methods if they want
 	friend class NvStripInfo;
+	friend class NvMeshletBuilder;
+	friend class NvIncrementalStripifier;
 };
 
 }  // namespace nv::tristrip::internal
@@ -0,0 +1,125 @@
+#ifndef NV_OBJECT_POOL_H
+#define NV_OBJECT_POOL_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Hands out objects of one type from big chunks of memory, instead of going to the heap
+// for each of them.  Everything still alive in the pool is destroyed and the chunks are
+// freed in one go when the pool itself is destroyed.
+// Delete() is there for objects which are better off going away early, their slot is
+// reused by the next New().
+template <typename T>
+class ObjectPool
+{
+public:
+	explicit ObjectPool(size_t firstChunkSize = 256) : nextChunkSize(firstChunkSize), chunkUsed(0), freeList(nullptr) {}
+	~ObjectPool() { Clear(); }
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	// makes sure the next numObjects allocations don't need another chunk
+	void Reserve(size_t numObjects)
+	{
+		if(chunks.empty() || (chunks.back().size - chunkUsed) < numObjects)
+			AddChunk(numObjects);
+	}
+
+	template <typename... Args>
+	T* New(Args&&... args)
+	{
+		Slot* slot = freeList;
+		if(slot != nullptr)
+			freeList = slot->next;
+		else
+		{
+			if(chunks.empty() || (chunkUsed == chunks.back().size))
+				AddChunk(nextChunkSize);
+
+			slot = &chunks.back().slots[chunkUsed++];
+		}
+
+		slot->bAlive = true;
+		return new (slot->storage) T(std::forward<Args>(args)...);
+	}
+
+	void Delete(T* object)
+	{
+		if(object == nullptr)
+			return;
+
+		object->~T();
+
+		Slot* slot = reinterpret_cast<Slot*>(object);
+		slot->bAlive = false;
+		slot->next = freeList;
+		freeList = slot;
+	}
+
+	// destroys every live object and gives back all the memory
+	void Clear()
+	{
+		if(!std::is_trivially_destructible<T>::value)
+		{
+			for(auto &c : chunks)
+			{
+				for(size_t j = 0; j < c.size; j++)
+				{
+					if(c.slots[j].bAlive)
+						reinterpret_cast<T*>(c.slots[j].storage)->~T();
+				}
+			}
+		}
+
+		chunks.clear();
+		chunkUsed = 0;
+		freeList = nullptr;
+	}
+
+private:
+	struct Slot
+	{
+		Slot() : next(nullptr), bAlive(false) {}
+
+		// the object has to come first, so an object pointer is also a slot pointer
+		union
+		{
+			alignas(T) unsigned char storage[sizeof(T)];
+			Slot* next;
+		};
+		bool bAlive;
+	};
+
+	struct Chunk
+	{
+		std::unique_ptr<Slot[]> slots;
+		size_t size;
+	};
+
+	void AddChunk(size_t size)
+	{
+		assert(size > 0);
+		chunks.emplace_back(Chunk{std::unique_ptr<Slot[]>(new Slot[size]), size});
+		chunkUsed = 0;
+
+		//grow geometrically, so a big mesh doesn't need lots of them
+		nextChunkSize = size * 2;
+	}
+
+	std::vector<Chunk> chunks;
+	size_t nextChunkSize;
+	size_t chunkUsed;
+	Slot* freeList;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
@@ -0,0 +1,191 @@
+#include "OverdrawOptimizer.h"
+
+#include "NvTriStripObjects.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+namespace {
+
+// runs a vertex through the cache, returns true on a miss
+bool UseVertex(VertexCache& vcache, size_t v)
+{
+	int entry = static_cast<int>(v);
+	if(vcache.InCache(entry))
+	{
+		vcache.Touch(entry);
+		return false;
+	}
+
+	vcache.AddEntry(entry);
+	return true;
+}
+
+MyVector Position(const float* positions, size_t positionStride, size_t v)
+{
+	const float* p = VertexPosition(positions, positionStride, v);
+
+	MyVector result{};
+	result.x = p[0];
+	result.y = p[1];
+	result.z = p[2];
+	return result;
+}
+
+}  // namespace
+
+
+float CalcListACMR(const size_t* indices, size_t numIndices, size_t numVertices,
+				   size_t cacheSize, CachePolicy policy)
+{
+	size_t numTriangles = numIndices / 3;
+	if(numTriangles == 0)
+		return 0.0f;
+
+	VertexCache vcache(std::max<size_t>(cacheSize, 1), policy, numVertices);
+
+	size_t numMisses = 0;
+	for(size_t i = 0; i < numTriangles * 3; i++)
+	{
+		if(UseVertex(vcache, indices[i]))
+			++numMisses;
+	}
+
+	return (float)numMisses / (float)numTriangles;
+}
+
+
+bool ReorderListForOverdraw(size_t* indices, size_t numIndices,
+							const float* positions, size_t positionStride, size_t numVertices,
+							size_t cacheSize, CachePolicy policy, float maxACMRRatio)
+{
+	size_t numTriangles = numIndices / 3;
+	if(numTriangles == 0)
+		return false;
+
+	cacheSize = std::max<size_t>(cacheSize, 1);
+	float targetACMR = CalcListACMR(indices, numIndices, numVertices, cacheSize, policy) * maxACMRRatio;
+
+	//cut the list into clusters, each one just long enough for its cold start to pay off
+	std::vector<size_t> clusterStarts;
+	{
+		VertexCache vcache(cacheSize, policy, numVertices);
+		size_t clusterMisses    = 0;
+		size_t clusterTriangles = 0;
+
+		clusterStarts.emplace_back(0);
+		for(size_t t = 0; t < numTriangles; t++)
+		{
+			for(size_t c = 0; c < 3; c++)
+			{
+				if(UseVertex(vcache, indices[t * 3 + c]))
+					++clusterMisses;
+			}
+			++clusterTriangles;
+
+			if( ((float)clusterMisses / (float)clusterTriangles <= targetACMR) && (t + 1 < numTriangles) )
+			{
+				clusterStarts.emplace_back(t + 1);
+				vcache.Clear();
+				clusterMisses    = 0;
+				clusterTriangles = 0;
+			}
+		}
+		clusterStarts.emplace_back(numTriangles);
+	}
+
+	size_t numClusters = clusterStarts.size() - 1;
+	if(numClusters < 2)
+		return false;
+
+	//area weighted centroid and normal of each cluster, and of the whole mesh
+	MyVertexVec clusters(numClusters, MyVertex{});
+	std::vector<float> clusterAreas(numClusters, 0.0f);
+	MyVector meshCentroid{};
+	float meshArea = 0.0f;
+
+	for(size_t k = 0; k < numClusters; k++)
+	{
+		MyVertex &cluster = clusters[k];
+		for(size_t t = clusterStarts[k]; t < clusterStarts[k + 1]; t++)
+		{
+			MyVector p0 = Position(positions, positionStride, indices[t * 3 + 0]);
+			MyVector p1 = Position(positions, positionStride, indices[t * 3 + 1]);
+			MyVector p2 = Position(positions, positionStride, indices[t * 3 + 2]);
+
+			float ex = p1.x - p0.x, ey = p1.y - p0.y, ez = p1.z - p0.z;
+			float fx = p2.x - p0.x, fy = p2.y - p0.y, fz = p2.z - p0.z;
+			float nx = ey * fz - ez * fy;
+			float ny = ez * fx - ex * fz;
+			float nz = ex * fy - ey * fx;
+			float area = std::sqrt(nx * nx + ny * ny + nz * nz);
+
+			cluster.nx += nx;
+			cluster.ny += ny;
+			cluster.nz += nz;
+
+			cluster.x += area * (p0.x + p1.x + p2.x) / 3.0f;
+			cluster.y += area * (p0.y + p1.y + p2.y) / 3.0f;
+			cluster.z += area * (p0.z + p1.z + p2.z) / 3.0f;
+			clusterAreas[k] += area;
+		}
+
+		meshCentroid.x += cluster.x;
+		meshCentroid.y += cluster.y;
+		meshCentroid.z += cluster.z;
+		meshArea += clusterAreas[k];
+
+		if(clusterAreas[k] > 0.0f)
+		{
+			cluster.x /= clusterAreas[k];
+			cluster.y /= clusterAreas[k];
+			cluster.z /= clusterAreas[k];
+		}
+	}
+
+	if(meshArea > 0.0f)
+	{
+		meshCentroid.x /= meshArea;
+		meshCentroid.y /= meshArea;
+		meshCentroid.z /= meshArea;
+	}
+
+	//how far out of the mesh each cluster faces
+	std::vector<float> outwardness(numClusters, 0.0f);
+	for(size_t k = 0; k < numClusters; k++)
+	{
+		const MyVertex &cluster = clusters[k];
+		float length = std::sqrt(cluster.nx * cluster.nx + cluster.ny * cluster.ny + cluster.nz * cluster.nz);
+		if(length > 0.0f)
+		{
+			outwardness[k] = ((cluster.x - meshCentroid.x) * cluster.nx +
+							  (cluster.y - meshCentroid.y) * cluster.ny +
+							  (cluster.z - meshCentroid.z) * cluster.nz) / length;
+		}
+	}
+
+	std::vector<size_t> order(numClusters);
+	std::iota(std::begin(order), std::end(order), size_t{0});
+	std::stable_sort(std::begin(order), std::end(order),
+		[&outwardness](size_t a, size_t b) noexcept {
+			return outwardness[a] > outwardness[b];
+		});
+
+	std::vector<size_t> reordered;
+	reordered.reserve(numTriangles * 3);
+	for(auto k : order)
+		reordered.insert(reordered.end(), indices + clusterStarts[k] * 3, indices + clusterStarts[k + 1] * 3);
+
+	//don't give away more of the cache than we're allowed to
+	if(CalcListACMR(reordered.data(), reordered.size(), numVertices, cacheSize, policy) > targetACMR)
+		return false;
+
+	std::copy(std::begin(reordered), std::end(reordered), indices);
+	return true;
+}
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,32 @@
+#ifndef NV_OVERDRAW_OPTIMIZER_H
+#define NV_OVERDRAW_OPTIMIZER_H
+
+#include "VertexCache.h"
+
+#include <cstddef>
+
+namespace nv::tristrip::internal {
+
+// Reorders the triangles of an indexed list in place to cut down overdraw, after
+// Tipsify (Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex Locality and
+// Reduced Overdraw", 2007).
+//
+// The list is cut into clusters of consecutive triangles, each ending as soon as its own
+// ACMR, starting from an empty cache, is down to maxACMRRatio times the ACMR of the whole
+// list.  Then the clusters are sorted so the ones facing away from the middle of the mesh
+// come first, as they tend to hide the others from most directions.
+// If the reordered list ends up with an ACMR more than maxACMRRatio times the original,
+// the list is left alone and false is returned.
+//
+// Vertex i is at positions[i * positionStride / sizeof(float)] and the two floats after it.
+bool ReorderListForOverdraw(size_t* indices, size_t numIndices,
+							const float* positions, size_t positionStride, size_t numVertices,
+							size_t cacheSize, CachePolicy policy, float maxACMRRatio);
+
+// Average number of cache misses per triangle of the list, with the given cache
+float CalcListACMR(const size_t* indices, size_t numIndices, size_t numVertices,
+				   size_t cacheSize, CachePolicy policy);
+
+}  // namespace nv::tristrip::internal
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef NV_PROFILER_H
+#define NV_PROFILER_H
+
+#include "NvTriStrip.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+// Timers and counters for the hot spots of the stripifier, filling in a StripifyProfile.
+//
+// Each thread adds to the StripifyProfile made current on it with NV_NVTS_PROFILE_THREAD,
+// so none of them ever wait on each other, and whoever owns the profiles merges them
+// once the threads are done.  Nothing is counted on a thread without a current profile.
+//
+// Without NV_NVTS_ENABLE_PROFILING all of the macros below compile to nothing.
+
+#ifdef NV_NVTS_ENABLE_PROFILING
+
+namespace nv::tristrip::internal {
+
+// the profile of this thread, if any
+inline thread_local StripifyProfile* currentProfile = nullptr;
+
+// makes a profile current on this thread while in scope
+class ScopedProfile
+{
+public:
+	explicit ScopedProfile(StripifyProfile& profile) : previous(currentProfile) { currentProfile = &profile; }
+	~ScopedProfile() { currentProfile = previous; }
+
+	ScopedProfile(const ScopedProfile&) = delete;
+	ScopedProfile& operator=(const ScopedProfile&) = delete;
+
+private:
+	StripifyProfile* previous;
+};
+
+// adds the time until it goes out of scope, or until Switch(), to a timer of the profile
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer(StripifyProfileTimer StripifyProfile::*in_timer) : timer(in_timer), start(std::chrono::steady_clock::now()) {}
+	~ScopedTimer() { Stop(); }
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	// stops this timer and starts the next one, for phases next to each other in one scope
+	void Switch(StripifyProfileTimer StripifyProfile::*next)
+	{
+		Stop();
+		timer = next;
+		start = std::chrono::steady_clock::now();
+	}
+
+private:
+	void Stop()
+	{
+		if(currentProfile == nullptr)
+			return;
+
+		StripifyProfileTimer &t = currentProfile->*timer;
+		t.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		++t.calls;
+	}
+
+	StripifyProfileTimer StripifyProfile::*timer;
+	std::chrono::steady_clock::time_point start;
+};
+
+// counts the steps of one walk down a chain locally, then adds them to a total and a
+// maximum of the profile when it goes out of scope
+class ScopedChainCounter
+{
+public:
+	ScopedChainCounter(uint64_t StripifyProfile::*in_total, uint64_t StripifyProfile::*in_max) : total(in_total), max(in_max), steps(0) {}
+	~ScopedChainCounter()
+	{
+		if(currentProfile == nullptr)
+			return;
+
+		currentProfile->*total += steps;
+		currentProfile->*max = std::max(currentProfile->*max, steps);
+	}
+
+	ScopedChainCounter(const ScopedChainCounter&) = delete;
+	ScopedChainCounter& operator=(const ScopedChainCounter&) = delete;
+
+	void Step() { ++steps; }
+
+private:
+	uint64_t StripifyProfile::*total;
+	uint64_t StripifyProfile::*max;
+	uint64_t steps;
+};
+
+inline void ProfileCount(uint64_t StripifyProfile::*counter, uint64_t n)
+{
+	if(currentProfile != nullptr)
+		currentProfile->*counter += n;
+}
+
+}  // namespace nv::tristrip::internal
+
+#define NV_NVTS_PROFILE_THREAD(name, profile) ::nv::tristrip::internal::ScopedProfile name(profile)
+#define NV_NVTS_PROFILE_TIMER(name, timer) ::nv::tristrip::internal::ScopedTimer name(&::nv::tristrip::StripifyProfile::timer)
+#define NV_NVTS_PROFILE_SWITCH(name, timer) name.Switch(&::nv::tristrip::StripifyProfile::timer)
+#define NV_NVTS_PROFILE_CHAIN(name, total, max) \
+	::nv::tristrip::internal::ScopedChainCounter name(&::nv::tristrip::StripifyProfile::total, &::nv::tristrip::StripifyProfile::max)
+#define NV_NVTS_PROFILE_STEP(name) name.Step()
+#define NV_NVTS_PROFILE_COUNT(counter, n) ::nv::tristrip::internal::ProfileCount(&::nv::tristrip::StripifyProfile::counter, (n))
+
+#else
+
+#define NV_NVTS_PROFILE_THREAD(name, profile) static_cast<void>(0)
+#define NV_NVTS_PROFILE_TIMER(name, timer) static_cast<void>(0)
+#define NV_NVTS_PROFILE_SWITCH(name, timer) static_cast<void>(0)
+#define NV_NVTS_PROFILE_CHAIN(name, total, max) static_cast<void>(0)
+#define NV_NVTS_PROFILE_STEP(name) static_cast<void>(0)
+#define NV_NVTS_PROFILE_COUNT(counter, n) static_cast<void>(0)
+
+#endif
+
+namespace nv::tristrip::internal {
+
+// adds the profile of another thread to into, the maximums are kept instead of added
+inline void MergeProfile(StripifyProfile& into, const StripifyProfile& from)
+{
+	auto merge = [](StripifyProfileTimer& a, const StripifyProfileTimer& b) {
+		a.seconds += b.seconds;
+		a.calls   += b.calls;
+	};
+
+	merge(into.buildStripifyInfo,        from.buildStripifyInfo);
+	merge(into.findAllStripsSetup,       from.findAllStripsSetup);
+	merge(into.findAllStripsExperiments, from.findAllStripsExperiments);
+	merge(into.findAllStripsSelect,      from.findAllStripsSelect);
+	merge(into.findAllStripsCommit,      from.findAllStripsCommit);
+	merge(into.findTraversal,            from.findTraversal);
+	merge(into.buildStrip,               from.buildStrip);
+	merge(into.splitUpStripsAndOptimize, from.splitUpStripsAndOptimize);
+	merge(into.removeSmallStrips,        from.removeSmallStrips);
+	merge(into.createStrips,             from.createStrips);
+
+	into.findAllStripsRounds   += from.findAllStripsRounds;
+	into.experimentsBuilt      += from.experimentsBuilt;
+	into.stripsBuilt           += from.stripsBuilt;
+	into.edgeLookups           += from.edgeLookups;
+	into.edgeProbes            += from.edgeProbes;
+	into.maxEdgeProbes          = std::max(into.maxEdgeProbes, from.maxEdgeProbes);
+	into.traversalEdgeSteps    += from.traversalEdgeSteps;
+	into.maxTraversalEdgeSteps  = std::max(into.maxTraversalEdgeSteps, from.maxTraversalEdgeSteps);
+	into.cacheTests            += from.cacheTests;
+}
+
+}  // namespace nv::tristrip::internal
+
+#endif
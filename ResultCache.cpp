@@ -0,0 +1,181 @@
+#include "ResultCache.h"
+#include "HashMix.h"
+#include "StripFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace nv::tristrip::internal {
+
+namespace {
+
+std::uint64_t RotateLeft(std::uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+std::uint64_t FloatBits(float f)
+{
+	std::uint32_t bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+// MurmurHash3 x64 128, fed a block of memory at a time
+class Hash128
+{
+public:
+	void Add(const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const unsigned char*>(data);
+		length += size;
+
+		//top up a partly filled block first
+		while( (numPending != 0) && (size != 0) )
+		{
+			pending[numPending++] = *bytes++;
+			--size;
+			if(numPending == sizeof(pending))
+			{
+				AddBlock(pending);
+				numPending = 0;
+			}
+		}
+
+		for(; size >= sizeof(pending); bytes += sizeof(pending), size -= sizeof(pending))
+			AddBlock(bytes);
+
+		std::memcpy(pending, bytes, size);
+		numPending = size;
+	}
+
+	void Finish(std::uint64_t& out1, std::uint64_t& out2)
+	{
+		std::uint64_t k1 = 0, k2 = 0;
+		for(size_t i = numPending; i-- > 8; )
+			k2 = (k2 << 8) | pending[i];
+		for(size_t i = std::min<size_t>(numPending, 8); i-- > 0; )
+			k1 = (k1 << 8) | pending[i];
+
+		k2 *= C2; k2 = RotateLeft(k2, 33); k2 *= C1; h2 ^= k2;
+		k1 *= C1; k1 = RotateLeft(k1, 31); k1 *= C2; h1 ^= k1;
+
+		h1 ^= length; h2 ^= length;
+		h1 += h2; h2 += h1;
+		h1 = HashMix(h1); h2 = HashMix(h2);
+		h1 += h2; h2 += h1;
+
+		out1 = h1;
+		out2 = h2;
+	}
+
+private:
+	static constexpr std::uint64_t C1 = 0x87c37b91114253d5ULL;
+	static constexpr std::uint64_t C2 = 0x4cf5ad432745937fULL;
+
+	void AddBlock(const unsigned char* block)
+	{
+		std::uint64_t k1, k2;
+		std::memcpy(&k1, block, 8);
+		std::memcpy(&k2, block + 8, 8);
+
+		k1 *= C1; k1 = RotateLeft(k1, 31); k1 *= C2; h1 ^= k1;
+		h1 = RotateLeft(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+		k2 *= C2; k2 = RotateLeft(k2, 33); k2 *= C1; h2 ^= k2;
+		h2 = RotateLeft(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+	}
+
+	std::uint64_t h1 = 0;
+	std::uint64_t h2 = 0;
+	std::uint64_t length = 0;
+
+	unsigned char pending[16];
+	size_t numPending = 0;
+};
+
+//tells the temporary files of different threads and processes apart
+std::atomic<std::uint64_t> numStored{0};
+
+}  // namespace
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// CacheFileName()
+//
+// directory/<32 hex digits of the hash>.nvts
+//
+template<typename InIndexT>
+std::string CacheFileName(const char* directory, const StripifyOptions& options, size_t outIndexSize,
+						  const InIndexT* indices, size_t numIndices)
+{
+	//everything which makes a difference to the output, and nothing else, so how many
+	// threads it ran on or who gets the profile doesn't.  The cache of the hardware profile
+	// is in cacheSize and bLRUCache by now
+	const HardwareProfile* profile = options.hardwareProfile;
+	const std::uint64_t key[] = {
+		RESULT_CACHE_VERSION, STRIP_FILE_VERSION, sizeof(InIndexT), outIndexSize, numIndices,
+		options.cacheSize, options.bStitchStrips, options.minStripSize, options.bListsOnly,
+		options.numSamples, options.workBudget, options.bStopAtFullCover, options.bLRUCache,
+		static_cast<std::uint64_t>(options.listOptimizer), options.bRestartStrips, options.chunkSize,
+		profile != nullptr, FloatBits(profile ? profile->vertexCost : 0.0f), FloatBits(profile ? profile->degenerateCost : 0.0f),
+		FloatBits(profile ? profile->restartCost : 0.0f), FloatBits(profile ? profile->drawCallCost : 0.0f)
+	};
+
+	Hash128 hash;
+	hash.Add(key, sizeof(key));
+	hash.Add(indices, numIndices * sizeof(InIndexT));
+
+	std::uint64_t h1, h2;
+	hash.Finish(h1, h2);
+
+	char name[40];
+	std::snprintf(name, sizeof(name), "%016llx%016llx.nvts", static_cast<unsigned long long>(h1), static_cast<unsigned long long>(h2));
+
+	std::string fileName(directory);
+	if( !fileName.empty() && (fileName.back() != '/') && (fileName.back() != '\\') )
+		fileName += '/';
+	return fileName + name;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// StoreCacheFile()
+//
+// Writes a temporary file next to fileName, then renames it into place
+//
+template<typename IndexT>
+void StoreCacheFile(const std::string& fileName, const BasicStripifyResult<IndexT>& result)
+{
+	const std::uint64_t unique = numStored++ ^
+		std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+		static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+	char suffix[32];
+	std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp", static_cast<unsigned long long>(unique));
+	const std::string tempName = fileName + suffix;
+
+	std::FILE* file = std::fopen(tempName.c_str(), "wb");
+	if(file == nullptr)
+		return;
+
+	bool bWritten = WriteStripFile(file, result);
+	bWritten = (std::fclose(file) == 0) && bWritten;
+
+	//somebody else may have stored the same result first, which is just as good
+	if( !bWritten || (std::rename(tempName.c_str(), fileName.c_str()) != 0) )
+		std::remove(tempName.c_str());
+}
+
+//the index widths we cache
+template std::string CacheFileName<uint16_t>(const char*, const StripifyOptions&, size_t, const uint16_t*, size_t);
+template std::string CacheFileName<uint32_t>(const char*, const StripifyOptions&, size_t, const uint32_t*, size_t);
+template void StoreCacheFile<uint16_t>(const std::string&, const BasicStripifyResult<uint16_t>&);
+template void StoreCacheFile<uint32_t>(const std::string&, const BasicStripifyResult<uint32_t>&);
+
+}  // namespace nv::tristrip::internal
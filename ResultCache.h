@@ -0,0 +1,34 @@
+#ifndef NV_RESULT_CACHE_H
+#define NV_RESULT_CACHE_H
+
+#include "NvTriStrip.h"
+
+#include <cstddef>
+#include <string>
+
+namespace nv::tristrip::internal {
+
+// Where GenerateStrips() keeps the results it has worked out before, see cacheDirectory in
+// StripifyOptions.  Every result is a strip file of its own, named after a 128 bit hash
+// of the input indices and of everything in the options which changes the output, so a
+// different mesh or different options never find it.
+//
+// Bump this whenever the stripifier comes up with different output for the same input,
+// so the old results are no longer found.
+constexpr inline uint32_t RESULT_CACHE_VERSION{1};
+
+// The cache file of a mesh, stripified with options into outIndexSize byte indices
+template<typename InIndexT>
+std::string CacheFileName(const char* directory, const StripifyOptions& options, size_t outIndexSize,
+						  const InIndexT* indices, size_t numIndices);
+
+// Writes result into the cache as fileName.  It goes in under a name of its own first,
+// and is renamed into place once it is all there, so nobody ever maps half a result,
+// even when several processes cook the same mesh at once.  The cache is only ever an
+// optimization, so failing just means the result isn't stored.
+template<typename IndexT>
+void StoreCacheFile(const std::string& fileName, const BasicStripifyResult<IndexT>& result);
+
+}  // namespace nv::tristrip::internal
+
+#endif
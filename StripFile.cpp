@@ -0,0 +1,133 @@
+#include "StripFile.h"
+
+#include <cstring>
+
+namespace nv::tristrip::internal {
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ParseIndexFile()
+//
+// Checks the layout of an index file, and where its indices are
+//
+bool ParseIndexFile(const unsigned char* data, size_t size, IndexFileFormat format, IndexFileContents& contents)
+{
+	contents = IndexFileContents{data, 0, 0};
+
+	if(format != IndexFileFormat::IFF_HEADER)
+	{
+		contents.indexSize = (format == IndexFileFormat::IFF_RAW16) ? 2 : 4;
+		contents.numIndices = size / contents.indexSize;
+		return (size % contents.indexSize) == 0;
+	}
+
+	IndexFileHeader header;
+	if(size < sizeof(header))
+		return false;
+
+	std::memcpy(&header, data, sizeof(header));
+	if( (header.magic != INDEX_FILE_MAGIC) || (header.version != INDEX_FILE_VERSION) ||
+		((header.indexSize != 2) && (header.indexSize != 4)) )
+		return false;
+
+	//the indices have to be all there, without overflowing on the way
+	const size_t maxIndices = (size - sizeof(header)) / header.indexSize;
+	if(header.numIndices > maxIndices)
+		return false;
+
+	contents.indices    = data + sizeof(header);
+	contents.numIndices = static_cast<size_t>(header.numIndices);
+	contents.indexSize  = header.indexSize;
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// ParseStripFile()
+//
+// Checks the layout of a strip file, and where its groups and indices are
+//
+bool ParseStripFile(const unsigned char* data, size_t size, StripFileContents& contents)
+{
+	contents = StripFileContents{nullptr, 0, nullptr, 0, 0};
+
+	StripFileHeader header;
+	if(size < sizeof(header))
+		return false;
+
+	std::memcpy(&header, data, sizeof(header));
+	if( (header.magic != STRIP_FILE_MAGIC) || (header.version != STRIP_FILE_VERSION) ||
+		((header.indexSize != 2) && (header.indexSize != 4)) )
+		return false;
+
+	//the groups and indices have to be exactly what's left, without overflowing on the way
+	size_t left = size - sizeof(header);
+	if(header.numGroups > left / sizeof(StripFileGroup))
+		return false;
+
+	left -= header.numGroups * sizeof(StripFileGroup);
+	if( (header.numIndices > left / header.indexSize) || (header.numIndices * header.indexSize != left) )
+		return false;
+
+	const auto* groups = reinterpret_cast<const StripFileGroup*>(data + sizeof(header));
+
+	uint64_t numGroupIndices = 0;
+	for(size_t i = 0; i < header.numGroups; i++)
+	{
+		if( (groups[i].type > static_cast<uint32_t>(PrimType::PT_FAN)) || (groups[i].numIndices > header.numIndices - numGroupIndices) )
+			return false;
+
+		numGroupIndices += groups[i].numIndices;
+	}
+
+	if(numGroupIndices != header.numIndices)
+		return false;
+
+	contents.groups     = groups;
+	contents.numGroups  = header.numGroups;
+	contents.indices    = data + sizeof(header) + header.numGroups * sizeof(StripFileGroup);
+	contents.numIndices = static_cast<size_t>(header.numIndices);
+	contents.indexSize  = header.indexSize;
+	return true;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////////////////
+// WriteStripFile()
+//
+// The header, the groups, and all the indices in one go
+//
+template<typename IndexT>
+bool WriteStripFile(std::FILE* file, const BasicStripifyResult<IndexT>& result)
+{
+	StripFileHeader header;
+	header.magic      = STRIP_FILE_MAGIC;
+	header.version    = STRIP_FILE_VERSION;
+	header.indexSize  = sizeof(IndexT);
+	header.numGroups  = static_cast<uint32_t>(result.NumGroups());
+	header.numIndices = result.NumIndices();
+
+	if( (header.numGroups != result.NumGroups()) || (std::fwrite(&header, sizeof(header), 1, file) != 1) )
+		return false;
+
+	for(size_t i = 0; i < result.NumGroups(); i++)
+	{
+		StripFileGroup group;
+		group.type       = static_cast<uint32_t>(result.GroupType(i));
+		group.reserved   = 0;
+		group.numIndices = result.NumIndices(i);
+
+		if(std::fwrite(&group, sizeof(group), 1, file) != 1)
+			return false;
+	}
+
+	if(result.NumIndices() == 0)
+		return true;
+
+	return std::fwrite(result.Indices(), sizeof(IndexT), result.NumIndices(), file) == result.NumIndices();
+}
+
+//the index widths strip files hold
+template bool WriteStripFile<uint16_t>(std::FILE*, const BasicStripifyResult<uint16_t>&);
+template bool WriteStripFile<uint32_t>(std::FILE*, const BasicStripifyResult<uint32_t>&);
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,44 @@
+#ifndef NV_STRIP_FILE_H
+#define NV_STRIP_FILE_H
+
+#include "NvTriStrip.h"
+
+#include <cstddef>
+#include <cstdio>
+
+namespace nv::tristrip::internal {
+
+// The indices an index file holds, pointing right into its contents
+struct IndexFileContents
+{
+	const void* indices;
+	size_t numIndices;
+	size_t indexSize;  // 2 or 4
+};
+
+// Finds the indices in the contents of an index file, see NvTriStrip.h for what those
+// look like.  Returns false if data isn't what format says, or is too short for it.
+// data has to be aligned for the indices, like the start of a mapped file is.
+bool ParseIndexFile(const unsigned char* data, size_t size, IndexFileFormat format, IndexFileContents& contents);
+
+// The groups and indices a strip file holds, pointing right into its contents
+struct StripFileContents
+{
+	const StripFileGroup* groups;
+	size_t numGroups;
+	const void* indices;
+	size_t numIndices;
+	size_t indexSize;  // 2 or 4
+};
+
+// Finds the groups and indices in the contents of a strip file, returns false if data
+// isn't one, or doesn't add up.  data has to be 8 byte aligned, like a mapped file is.
+bool ParseStripFile(const unsigned char* data, size_t size, StripFileContents& contents);
+
+// Writes result into file as a strip file, returns false if writing failed
+template<typename IndexT>
+bool WriteStripFile(std::FILE* file, const BasicStripifyResult<IndexT>& result);
+
+}  // namespace nv::tristrip::internal
+
+#endif
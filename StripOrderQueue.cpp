@@ -0,0 +1,180 @@
+#include "StripOrderQueue.h"
+
+#include <cassert>
+
+namespace nv::tristrip::internal {
+
+void StripOrderQueue::AddStrip(const std::vector<int>& vertices, size_t in_numFaces, bool bStartsCW)
+{
+	if(stripVertexStarts.empty())
+		stripVertexStarts.emplace_back(0);
+
+	stripVertices.insert(stripVertices.end(), vertices.begin(), vertices.end());
+	stripVertexStarts.emplace_back(stripVertices.size());
+
+	numFaces.emplace_back(in_numFaces);
+	bCW.emplace_back(bStartsCW);
+}
+
+
+void StripOrderQueue::Build(size_t numVertices)
+{
+	size_t numStrips = numFaces.size();
+
+	//count the uses of each vertex, then sort them by vertex
+	std::vector<size_t> counts(numVertices + 1, 0);
+	for(auto v : stripVertices)
+	{
+		assert( (v >= 0) && (static_cast<size_t>(v) < numVertices) );
+		++counts[v + 1];
+	}
+
+	for(size_t v = 0; v < numVertices; v++)
+		counts[v + 1] += counts[v];
+
+	std::vector<size_t> allUses(stripVertices.size());
+	for(size_t s = 0; s < numStrips; s++)
+	{
+		for(size_t i = stripVertexStarts[s]; i < stripVertexStarts[s + 1]; i++)
+			allUses[counts[stripVertices[i]]++] = s;
+	}
+
+	//the strips come in order, so the uses of a vertex by one strip are next to each
+	// other, and fold into one
+	uses.clear();
+	useStarts.assign(numVertices + 1, 0);
+	size_t first = 0;
+	for(size_t v = 0; v < numVertices; v++)
+	{
+		useStarts[v] = uses.size();
+		for(size_t i = first; i < counts[v]; i++)
+		{
+			if( (uses.size() > useStarts[v]) && (uses.back().strip == allUses[i]) )
+				++uses.back().count;
+			else
+				uses.emplace_back(Use{allUses[i], 1});
+		}
+		first = counts[v];
+	}
+	useStarts[numVertices] = uses.size();
+
+	std::vector<int>().swap(stripVertices);
+	std::vector<size_t>().swap(stripVertexStarts);
+
+	//nothing is in the cache yet
+	hits.assign(numStrips, 0);
+	scores.assign(numStrips, 0.0f);
+	bRemoved.assign(numStrips, false);
+	bDirty.assign(numStrips, false);
+	dirtyStrips.clear();
+
+	buckets.clear();
+	for(size_t s = 0; s < numStrips; s++)
+		Insert(s);
+}
+
+
+void StripOrderQueue::AddHits(int v, int sign)
+{
+	for(size_t i = useStarts[v]; i < useStarts[v + 1]; i++)
+	{
+		const Use &use = uses[i];
+		if(bRemoved[use.strip])
+			continue;
+
+		hits[use.strip] += sign * use.count;
+
+		if(!bDirty[use.strip])
+		{
+			bDirty[use.strip] = true;
+			dirtyStrips.emplace_back(use.strip);
+		}
+	}
+}
+
+
+// same as NvStripifier::CalcNumHitsStrip()
+float StripOrderQueue::Score(size_t strip) const
+{
+	return numFaces[strip] != 0 ? ((float)hits[strip] / (float)numFaces[strip]) : 0;
+}
+
+
+void StripOrderQueue::Insert(size_t strip)
+{
+	scores[strip] = Score(strip);
+
+	Bucket &bucket = buckets[scores[strip]];
+	bucket.strips.insert(strip);
+	bucket.stripsByCW[bCW[strip] ? 1 : 0].insert(strip);
+}
+
+
+void StripOrderQueue::Erase(size_t strip)
+{
+	auto it = buckets.find(scores[strip]);
+	assert(it != buckets.end());
+
+	it->second.strips.erase(strip);
+	it->second.stripsByCW[bCW[strip] ? 1 : 0].erase(strip);
+
+	if(it->second.strips.empty())
+		buckets.erase(it);
+}
+
+
+void StripOrderQueue::Remove(size_t strip)
+{
+	assert(!bRemoved[strip]);
+
+	Erase(strip);
+	bRemoved[strip] = true;
+}
+
+
+void StripOrderQueue::Rescore()
+{
+	for(auto s : dirtyStrips)
+	{
+		bDirty[s] = false;
+
+		if(bRemoved[s] || (Score(s) == scores[s]))
+			continue;
+
+		Erase(s);
+		Insert(s);
+	}
+
+	dirtyStrips.clear();
+}
+
+
+size_t StripOrderQueue::Next()
+{
+	Rescore();
+
+	if(buckets.empty())
+		return NONE;
+
+	return *buckets.begin()->second.strips.begin();
+}
+
+
+size_t StripOrderQueue::Next(bool bWantsCW)
+{
+	Rescore();
+
+	if(buckets.empty())
+		return NONE;
+
+	const Bucket &best = buckets.begin()->second;
+	size_t first = *best.strips.begin();
+
+	const std::set<size_t> &wanted = best.stripsByCW[bWantsCW ? 1 : 0];
+	if(!wanted.empty() && (*wanted.rbegin() > first))
+		return *wanted.rbegin();
+
+	return first;
+}
+
+}  // namespace nv::tristrip::internal
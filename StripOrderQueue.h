@@ -0,0 +1,88 @@
+#ifndef NV_STRIP_ORDER_QUEUE_H
+#define NV_STRIP_ORDER_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Keeps the strips still waiting to be ordered sorted by their number of vertex cache
+// hits per face, so the next strip to add doesn't need a scan over all of them.
+//
+// Every vertex knows which strips use it, and how often.  When a vertex enters or leaves
+// the cache only those strips are rescored.
+//
+// Next() picks exactly the strip the original scan would: of the strips with the best
+// score, the last one starting with the wanted winding, as long as it comes after the
+// first of them, and otherwise the first.
+// Single faces can be ordered the same way, as strips of one face each.
+class StripOrderQueue
+{
+public:
+	static constexpr size_t NONE = ~size_t{0};
+
+	// Adds the next strip, vertices holds the vertex indices of all its faces, repeats included
+	void AddStrip(const std::vector<int>& vertices, size_t numFaces, bool bStartsCW);
+
+	// Call once all the strips are in, with an empty cache, before anything else
+	void Build(size_t numVertices);
+
+	// The cache tells us about every vertex that goes in or out
+	void VertexEntered(int v) { AddHits(v, 1); }
+	void VertexLeft(int v) { AddHits(v, -1); }
+
+	// Takes a strip out of the running
+	void Remove(size_t strip);
+
+	// The strip to add next, NONE once they're all gone
+	size_t Next(bool bWantsCW);
+
+	// Same, but without caring about the winding, so the first strip with the best score
+	size_t Next();
+
+private:
+	struct Use
+	{
+		size_t strip;
+		int    count;  //how many of the strip's face corners are this vertex
+	};
+
+	// strips with the same score, by index
+	struct Bucket
+	{
+		std::set<size_t> strips;
+		std::set<size_t> stripsByCW[2];
+	};
+
+	using BucketMap = std::map<float, Bucket, std::greater<float>>;
+
+	void AddHits(int v, int sign);
+	float Score(size_t strip) const;
+	void Insert(size_t strip);
+	void Erase(size_t strip);
+	void Rescore();
+
+	// vertex -> strips using it, vertex v's uses are uses[useStarts[v]] to uses[useStarts[v + 1]]
+	std::vector<Use>    uses;
+	std::vector<size_t> useStarts;
+
+	// per strip
+	std::vector<int>    stripVertices;  // all the added vertices, until Build()
+	std::vector<size_t> stripVertexStarts;
+	std::vector<size_t> numFaces;
+	std::vector<int>    hits;
+	std::vector<float>  scores;  // the score the strip is filed under
+	std::vector<bool>   bCW;
+	std::vector<bool>   bRemoved;
+	std::vector<bool>   bDirty;
+
+	std::vector<size_t> dirtyStrips;
+	BucketMap           buckets;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
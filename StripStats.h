@@ -0,0 +1,127 @@
+#ifndef NV_STRIP_STATS_H
+#define NV_STRIP_STATS_H
+
+#include "VertexCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Draws the output of the stripifier through a simulated vertex cache, counting the
+// misses, degenerates and strips on the way, like the GPU would see them.
+// Groups are drawn one after the other with the cache carried across, as they would be
+// in a single draw call.
+class StripStatsCounter
+{
+public:
+	StripStatsCounter(size_t cacheSize, CachePolicy policy) : vcache(std::max<size_t>(cacheSize, 1), policy) { }
+
+	template<typename IndexT>
+	void AddList(const IndexT* indices, size_t numIndices)
+	{
+		numTotalIndices += numIndices;
+
+		for(size_t i = 0; i + 2 < numIndices; i += 3)
+			AddTriangle(indices[i], indices[i + 1], indices[i + 2], false);
+
+		for(size_t i = 0; i < numIndices; i++)
+			Use(indices[i]);
+	}
+
+	template<typename IndexT>
+	void AddFan(const IndexT* indices, size_t numIndices)
+	{
+		numTotalIndices += numIndices;
+
+		for(size_t i = 1; i + 1 < numIndices; i++)
+			AddTriangle(indices[0], indices[i], indices[i + 1], false);
+
+		for(size_t i = 0; i < numIndices; i++)
+			Use(indices[i]);
+	}
+
+	// restartIndex ends one strip and starts the next, anywhere in the group
+	template<typename IndexT>
+	void AddStrip(const IndexT* indices, size_t numIndices, IndexT restartIndex)
+	{
+		numTotalIndices += numIndices;
+
+		size_t stripStart = 0;
+		for(size_t i = 0; i <= numIndices; i++)
+		{
+			if( (i < numIndices) && (indices[i] != restartIndex) )
+			{
+				Use(indices[i]);
+				continue;
+			}
+
+			for(size_t j = stripStart; j + 2 < i; j++)
+				AddTriangle(indices[j], indices[j + 1], indices[j + 2], true);
+
+			if(i > stripStart)
+				++numStrips;
+
+			stripStart = i + 1;
+		}
+	}
+
+	size_t NumIndices() const { return numTotalIndices; }
+	size_t NumTriangles() const { return numTriangles; }
+	size_t NumDegenerates() const { return numDegenerates; }
+	size_t NumStrips() const { return numStrips; }
+	size_t NumStripTriangles() const { return numStripTriangles; }
+	size_t NumVertices() const { return numVertices; }
+	size_t NumCacheMisses() const { return numMisses; }
+
+private:
+	void AddTriangle(size_t v0, size_t v1, size_t v2, bool bInStrip)
+	{
+		if( (v0 == v1) || (v0 == v2) || (v1 == v2) )
+		{
+			++numDegenerates;
+			return;
+		}
+
+		++numTriangles;
+		if(bInStrip)
+			++numStripTriangles;
+	}
+
+	void Use(size_t v)
+	{
+		if(v >= bUsed.size())
+			bUsed.resize(v + 1, false);
+
+		if(!bUsed[v])
+		{
+			bUsed[v] = true;
+			++numVertices;
+		}
+
+		int entry = static_cast<int>(v);
+		if(vcache.InCache(entry))
+			vcache.Touch(entry);
+		else
+		{
+			vcache.AddEntry(entry);
+			++numMisses;
+		}
+	}
+
+	VertexCache vcache;
+	std::vector<bool> bUsed;
+
+	size_t numTotalIndices   = 0;
+	size_t numTriangles      = 0;
+	size_t numDegenerates    = 0;
+	size_t numStrips         = 0;
+	size_t numStripTriangles = 0;
+	size_t numVertices       = 0;
+	size_t numMisses         = 0;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
@@ -0,0 +1,234 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace nv::tristrip::internal {
+
+namespace {
+
+// which pool and queue the current thread is working for, if any
+struct CurrentWorker
+{
+	const ThreadPool* pool;
+	size_t queueIndex;
+};
+
+thread_local CurrentWorker currentWorker{nullptr, 0};
+
+// Makes the calling thread work for the given queue until it goes out of scope
+class ScopedWorker
+{
+public:
+	ScopedWorker(const ThreadPool* pool, size_t queueIndex) : previous(currentWorker)
+	{
+		currentWorker.pool       = pool;
+		currentWorker.queueIndex = queueIndex;
+	}
+	~ScopedWorker() { currentWorker = previous; }
+
+private:
+	CurrentWorker previous;
+};
+
+}  // namespace
+
+
+unsigned int ThreadPool::DefaultNumThreads()
+{
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+ThreadPool::ThreadPool(unsigned int numThreads) : nextQueue(0), numQueued(0), epoch(0), bStop(false)
+{
+	if(numThreads == 0)
+		numThreads = DefaultNumThreads();
+
+	queues.reserve(numThreads);
+	for(unsigned int i = 0; i < numThreads; i++)
+		queues.emplace_back(std::make_unique<WorkQueue>());
+
+	//queue 0 belongs to the thread that created us
+	workers.reserve(numThreads - 1);
+	for(size_t i = 1; i < numThreads; i++)
+		workers.emplace_back(&ThreadPool::WorkerMain, this, i);
+}
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		bStop = true;
+		++epoch;
+	}
+	sleepCondition.notify_all();
+
+	for(auto &w : workers)
+		w.join();
+}
+
+
+size_t ThreadPool::CurrentThreadIndex() const
+{
+	return (currentWorker.pool == this) ? currentWorker.queueIndex : 0;
+}
+
+
+size_t ThreadPool::CurrentQueue()
+{
+	if(currentWorker.pool == this)
+		return currentWorker.queueIndex;
+
+	//not one of ours, deal the task to the next queue in line
+	return nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+}
+
+
+void ThreadPool::Submit(Task task)
+{
+	size_t queueIndex = CurrentQueue();
+	bool bOwnQueue = (currentWorker.pool == this);
+
+	{
+		std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+
+		//a worker adding to its own queue wants its new tasks done first, everybody
+		// else wants their tasks done in the order they were handed to us
+		if(bOwnQueue)
+			queues[queueIndex]->tasks.emplace_front(std::move(task));
+		else
+			queues[queueIndex]->tasks.emplace_back(std::move(task));
+	}
+
+	numQueued.fetch_add(1, std::memory_order_release);
+	Notify();
+}
+
+
+void ThreadPool::Notify()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		++epoch;
+	}
+	sleepCondition.notify_all();
+}
+
+
+bool ThreadPool::PopTask(size_t queueIndex, Task& task)
+{
+	WorkQueue &queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if(queue.tasks.empty())
+		return false;
+
+	task = std::move(queue.tasks.front());
+	queue.tasks.pop_front();
+	return true;
+}
+
+
+bool ThreadPool::StealTask(size_t thiefIndex, Task& task)
+{
+	size_t numQueues = queues.size();
+	for(size_t i = 1; i < numQueues; i++)
+	{
+		WorkQueue &victim = *queues[(thiefIndex + i) % numQueues];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+
+		if(victim.tasks.empty())
+			continue;
+
+		//take from the end the owner isn't working on
+		task = std::move(victim.tasks.back());
+		victim.tasks.pop_back();
+		return true;
+	}
+
+	return false;
+}
+
+
+bool ThreadPool::RunOne()
+{
+	if(numQueued.load(std::memory_order_acquire) == 0)
+		return false;
+
+	size_t queueIndex = CurrentThreadIndex();
+
+	Task task;
+	if(!PopTask(queueIndex, task) && !StealTask(queueIndex, task))
+		return false;
+
+	numQueued.fetch_sub(1, std::memory_order_relaxed);
+
+	ScopedWorker worker(this, queueIndex);
+	task();
+
+	return true;
+}
+
+
+void ThreadPool::WaitFor(const std::atomic<size_t>& pending)
+{
+	while(pending.load(std::memory_order_acquire) != 0)
+	{
+		std::uint64_t seenEpoch;
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			seenEpoch = epoch;
+		}
+
+		if(RunOne())
+			continue;
+
+		//nothing to help with, sleep until a task finishes or a new one shows up
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [&] {
+			return (epoch != seenEpoch) || (pending.load(std::memory_order_acquire) == 0);
+		});
+	}
+}
+
+
+void ThreadPool::WorkerMain(size_t queueIndex)
+{
+	ScopedWorker worker(this, queueIndex);
+
+	while(1)
+	{
+		std::uint64_t seenEpoch;
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			if(bStop)
+				break;
+			seenEpoch = epoch;
+		}
+
+		if(RunOne())
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [&] { return bStop || (epoch != seenEpoch); });
+	}
+}
+
+
+void TaskGroup::Run(ThreadPool::Task task)
+{
+	pending.fetch_add(1, std::memory_order_relaxed);
+
+	//the group may be gone as soon as pending hits zero, so don't reach the pool through it
+	ThreadPool &threadPool = pool;
+	threadPool.Submit([this, &threadPool, task = std::move(task)] {
+		task();
+
+		if(pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			threadPool.Notify();
+	});
+}
+
+}  // namespace nv::tristrip::internal
@@ -0,0 +1,105 @@
+#ifndef NV_THREAD_POOL_H
+#define NV_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nv::tristrip::internal {
+
+// Small work stealing thread pool.
+//
+// Every thread owns a queue of tasks.  It takes work from the front of its own queue,
+// and when that runs dry it steals from the back of somebody else's queue, so the
+// threads keep each other busy until all the work is done.
+// The thread which created the pool takes part in the work while it is waiting, and
+// owns queue 0, so a pool of N threads only starts N - 1 new ones.
+class ThreadPool
+{
+public:
+	using Task = std::function<void()>;
+
+	// numThreads is the total number of threads to work with, 0 means one per hardware thread
+	explicit ThreadPool(unsigned int numThreads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	unsigned int GetNumThreads() const { return static_cast<unsigned int>(queues.size()); }
+
+	// Which of our threads is calling, 0 to GetNumThreads()-1.  Tasks can use this to pick
+	// per thread scratch space, threads which don't work for us get 0 like our creator.
+	size_t CurrentThreadIndex() const;
+
+	// Tasks submitted from one of our worker threads go to the front of that thread's queue,
+	// everything else is dealt around the queues one task at a time.
+	void Submit(Task task);
+
+	// Runs one queued task on the calling thread, returns false if there was nothing to do
+	bool RunOne();
+
+	// Blocks until pending reaches zero, running queued tasks in the meantime
+	void WaitFor(const std::atomic<size_t>& pending);
+
+	// Wakes every sleeping thread so it rechecks what it was waiting for
+	void Notify();
+
+	static unsigned int DefaultNumThreads();
+
+private:
+	struct WorkQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void WorkerMain(size_t queueIndex);
+
+	bool PopTask(size_t queueIndex, Task& task);
+	bool StealTask(size_t thiefIndex, Task& task);
+	size_t CurrentQueue();
+
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+	std::vector<std::thread> workers;
+
+	std::atomic<size_t> nextQueue;
+	std::atomic<size_t> numQueued;
+
+	// protects sleeping; epoch changes whenever there is something new to look at
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	std::uint64_t epoch;
+	bool bStop;
+};
+
+
+// Set of tasks which can be waited on together.
+// Tasks run from within a group may add more tasks to the same or to another group.
+class TaskGroup
+{
+public:
+	explicit TaskGroup(ThreadPool& inPool) : pool(inPool), pending(0) {}
+	~TaskGroup() { Wait(); }
+
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+
+	void Run(ThreadPool::Task task);
+	void Wait() { pool.WaitFor(pending); }
+
+private:
+	ThreadPool& pool;
+	std::atomic<size_t> pending;
+};
+
+}  // namespace nv::tristrip::internal
+
+#endif
@@ -2,74 +2,151 @@
 #define NV_VERTEX_CACHE_H
 
 #include <cassert>
-#include <cstring>
 #include <cstddef>
+#include <vector>
 
 namespace nv::tristrip::internal {
 
+// How the simulated post transform cache picks which vertex to throw out
+enum class CachePolicy
+{
+	FIFO,  // the one that went in first, hits change nothing
+	LRU    // the one used longest ago, hits move a vertex to the front
+};
+
+// Simulated post transform vertex cache.
+//
+// Every vertex in the cache is a node in a list running from the newest to the oldest
+// entry, and the links are kept per vertex, so finding, adding and throwing out vertices
+// all take the same time no matter how big the cache is.
+// The per vertex arrays grow as bigger vertex indices come in, give the number of
+// vertices up front to save that.
 class VertexCache
 {
 public:
-	explicit VertexCache(size_t size)
+	explicit VertexCache(size_t size, CachePolicy in_policy = CachePolicy::FIFO, size_t numVertices = 0)
 	{
+		assert(size > 0);
 		numEntries = size;
-		
-		entries = new int[numEntries];
-		
-		for(size_t i = 0; i < numEntries; i++)
-			entries[i] = -1;
+		policy = in_policy;
+
+		links.resize(numVertices);
+		Clear();
 	}
-		
+
 	VertexCache() : VertexCache(16) { }
-	~VertexCache() { delete[] entries; entries = nullptr; }
-	
+
 	bool InCache(int entry) const
 	{
-		for(size_t i = 0; i < numEntries; i++)
-		{
-			if(entries[i] == entry)
-			{
-				return true;
-			}
-		}
-		
-		return false;
+		return (entry >= 0) && (static_cast<size_t>(entry) < links.size()) && links[entry].bInCache;
 	}
-	
+
+	// Adds an entry which is not in the cache yet at the front, returns the entry
+	// thrown out to make room for it, or -1 if there was room
 	int AddEntry(int entry)
 	{
-		int removed = entries[numEntries - 1];
-		
-		//push everything right one
-		for(std::ptrdiff_t i = numEntries - 2; i >= 0; i--)
+		assert(entry >= 0);
+		assert(!InCache(entry));
+
+		if(static_cast<size_t>(entry) >= links.size())
+			links.resize(entry + 1);
+
+		int removed = -1;
+		if(numUsed == numEntries)
 		{
-			entries[i + 1] = entries[i];
+			removed = oldest;
+			Unlink(removed);
 		}
-		
-		entries[0] = entry;
-		
+
+		PushFront(entry);
 		return removed;
 	}
 
+	// Tells the cache an entry in it was just used again
+	void Touch(int entry)
+	{
+		assert(InCache(entry));
+
+		if( (policy == CachePolicy::LRU) && (entry != newest) )
+		{
+			Unlink(entry);
+			PushFront(entry);
+		}
+	}
+
 	void Clear()
 	{
-		memset(entries, -1, sizeof(int) * numEntries);
+		//only the entries still in the list need their flags cleared
+		for(int entry = newest; entry != -1; entry = links[entry].older)
+			links[entry].bInCache = false;
+
+		newest = -1;
+		oldest = -1;
+		numUsed = 0;
 	}
-	
-	void Copy(VertexCache* inVcache) const
+
+	// the index'th newest entry, -1 for the slots which are still empty
+	int At(size_t index) const
 	{
-		for(size_t i = 0; i < numEntries; i++)
-		{
-			inVcache->Set(i, entries[i]);
-		}
+		assert(index < numEntries);
+
+		int entry = newest;
+		for(size_t i = 0; (i < index) && (entry != -1); i++)
+			entry = links[entry].older;
+
+		return entry;
 	}
 
-	int At(size_t index) const { assert(index < numEntries); return entries[index]; }
-	void Set(size_t index, int value) { assert(index < numEntries); entries[index] = value; }
+	size_t Size() const { return numEntries; }
+	CachePolicy Policy() const { return policy; }
 
 private:
-  int *entries;
-  size_t numEntries;
+	struct Link
+	{
+		int  newer  = -1;
+		int  older  = -1;
+		bool bInCache = false;
+	};
+
+	void PushFront(int entry)
+	{
+		Link &link = links[entry];
+		link.newer = -1;
+		link.older = newest;
+		link.bInCache = true;
+
+		if(newest != -1)
+			links[newest].newer = entry;
+		else
+			oldest = entry;
+
+		newest = entry;
+		++numUsed;
+	}
+
+	void Unlink(int entry)
+	{
+		Link &link = links[entry];
+
+		if(link.newer != -1)
+			links[link.newer].older = link.older;
+		else
+			newest = link.older;
+
+		if(link.older != -1)
+			links[link.older].newer = link.newer;
+		else
+			oldest = link.newer;
+
+		link.bInCache = false;
+		--numUsed;
+	}
+
+	std::vector<Link> links;
+	int newest = -1, oldest = -1;
+	size_t numUsed = 0;
+	size_t numEntries;
+	CachePolicy policy;
 };
 
 }  // namespace nv::tristrip::internal
@@ -0,0 +1,334 @@
+// Stripifies a corpus of meshes at a few cache sizes and output modes, and reports how
+// fast it went, how much memory it took, and how well the output uses the cache.
+//
+// usage: nvTriStripBenchmark [options] [mesh.obj|mesh.ply ...]
+//
+//  --scale F       scale the synthetic meshes' triangle counts by F (default 1)
+//  --no-synthetic  only run the meshes given on the command line
+//  --cache A,B,..  cache sizes to optimize for and measure with (default 16,24,32,64)
+//  --modes A,B,..  any of stitch, separate, restart, lists, tipsify (default all of them)
+//  --threads N     StripifyOptions::numThreads (default 0, all hardware threads)
+//  --samples N     StripifyOptions::numSamples (default 10)
+//  --lru           optimize for and measure with an LRU cache instead of a FIFO
+//  --repeat N      run each case N times and keep the fastest (default 1)
+
+#include "MeshCorpus.h"
+#include "NvTriStrip.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Heap tracking
+//
+// Every allocation in the process goes through these, so the peak number of bytes live
+//  during a run can be told apart from what was there before it.
+//
+namespace {
+
+std::atomic<size_t> liveBytes{0};
+std::atomic<size_t> peakBytes{0};
+
+// keeps the block size in front of every block, as big as the strictest alignment
+constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* TrackedAlloc(size_t size)
+{
+	auto* block = static_cast<unsigned char*>(malloc(size + HEADER_SIZE));
+	if(block == nullptr)
+	{
+		fprintf(stderr, "out of memory\n");
+		abort();
+	}
+
+	memcpy(block, &size, sizeof(size));
+
+	size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	size_t peak = peakBytes.load(std::memory_order_relaxed);
+	while( (live > peak) && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed) )
+		;
+
+	return block + HEADER_SIZE;
+}
+
+void TrackedFree(void* ptr)
+{
+	if(ptr == nullptr)
+		return;
+
+	auto* block = static_cast<unsigned char*>(ptr) - HEADER_SIZE;
+
+	size_t size;
+	memcpy(&size, block, sizeof(size));
+	liveBytes.fetch_sub(size, std::memory_order_relaxed);
+
+	free(block);
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return TrackedAlloc(size); }
+void* operator new[](size_t size) { return TrackedAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+void operator delete(void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { TrackedFree(ptr); }
+
+namespace nv::tristrip::benchmark {
+
+namespace {
+
+enum class Mode
+{
+	STITCH,
+	SEPARATE,
+	RESTART,
+	LISTS,
+	TIPSIFY
+};
+
+const char* const MODE_NAMES[] = {"stitch", "separate", "restart", "lists", "tipsify"};
+
+struct Settings
+{
+	float scale = 1.0f;
+	bool bSynthetic = true;
+	std::vector<unsigned int> cacheSizes = {CACHESIZE_GEFORCE1_2, CACHESIZE_GEFORCE3, 32, 64};
+	std::vector<Mode> modes = {Mode::STITCH, Mode::SEPARATE, Mode::RESTART, Mode::LISTS, Mode::TIPSIFY};
+	unsigned int numThreads = 0;
+	unsigned int numSamples = 10;
+	bool bLRUCache = false;
+	unsigned int numRepeats = 1;
+	std::vector<const char*> files;
+};
+
+// splits a comma separated list, false if any of it doesn't parse
+template<typename Parse>
+bool ParseList(const char* list, Parse parse)
+{
+	std::string item;
+	for(const char* c = list; ; c++)
+	{
+		if( (*c == ',') || (*c == '\0') )
+		{
+			if(item.empty() || !parse(item))
+				return false;
+			item.clear();
+
+			if(*c == '\0')
+				return true;
+		}
+		else
+			item += *c;
+	}
+}
+
+bool ParseUnsigned(const char* text, unsigned int& value)
+{
+	char* end = nullptr;
+	unsigned long parsed = strtoul(text, &end, 10);
+	if( (end == text) || (*end != '\0') )
+		return false;
+
+	value = static_cast<unsigned int>(parsed);
+	return true;
+}
+
+bool ParseArgs(int argc, char** argv, Settings& settings)
+{
+	for(int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+		bool bTakesValue = true;
+		bool bOk = true;
+
+		if(strcmp(arg, "--scale") == 0)
+			bOk = (value != nullptr) && ((settings.scale = (float)atof(value)) > 0.0f);
+		else if(strcmp(arg, "--cache") == 0)
+		{
+			settings.cacheSizes.clear();
+			bOk = (value != nullptr) && ParseList(value, [&settings](const std::string& item) {
+				unsigned int size = 0;
+				if(!ParseUnsigned(item.c_str(), size) || (size == 0))
+					return false;
+				settings.cacheSizes.emplace_back(size);
+				return true;
+			});
+		}
+		else if(strcmp(arg, "--modes") == 0)
+		{
+			settings.modes.clear();
+			bOk = (value != nullptr) && ParseList(value, [&settings](const std::string& item) {
+				for(size_t m = 0; m < sizeof(MODE_NAMES) / sizeof(MODE_NAMES[0]); m++)
+				{
+					if(item == MODE_NAMES[m])
+					{
+						settings.modes.emplace_back(static_cast<Mode>(m));
+						return true;
+					}
+				}
+				return false;
+			});
+		}
+		else if(strcmp(arg, "--threads") == 0)
+			bOk = (value != nullptr) && ParseUnsigned(value, settings.numThreads);
+		else if(strcmp(arg, "--samples") == 0)
+			bOk = (value != nullptr) && ParseUnsigned(value, settings.numSamples);
+		else if(strcmp(arg, "--repeat") == 0)
+			bOk = (value != nullptr) && ParseUnsigned(value, settings.numRepeats) && (settings.numRepeats > 0);
+		else
+		{
+			bTakesValue = false;
+			if(strcmp(arg, "--no-synthetic") == 0)
+				settings.bSynthetic = false;
+			else if(strcmp(arg, "--lru") == 0)
+				settings.bLRUCache = true;
+			else if(arg[0] == '-')
+				bOk = false;
+			else
+				settings.files.emplace_back(arg);
+		}
+
+		if(!bOk)
+		{
+			fprintf(stderr, "bad argument: %s%s%s\n", arg, bTakesValue ? " " : "", (bTakesValue && value) ? value : "");
+			return false;
+		}
+
+		if(bTakesValue)
+			++i;
+	}
+
+	return true;
+}
+
+StripifyOptions MakeOptions(const Settings& settings, Mode mode, unsigned int cacheSize)
+{
+	StripifyOptions options;
+	options.cacheSize      = cacheSize;
+	options.numThreads     = settings.numThreads;
+	options.numSamples     = settings.numSamples;
+	options.bLRUCache      = settings.bLRUCache;
+	options.bStitchStrips  = (mode != Mode::SEPARATE);
+	options.bRestartStrips = (mode == Mode::RESTART);
+	options.bListsOnly     = (mode == Mode::LISTS) || (mode == Mode::TIPSIFY);
+	options.listOptimizer  = (mode == Mode::TIPSIFY) ? ListOptimizer::LO_TIPSIFY : ListOptimizer::LO_STRIPS;
+	return options;
+}
+
+void PrintHeader()
+{
+	printf("%-14s %8s %8s %-8s %5s %9s %9s %6s %6s %8s %8s %8s %8s %8s %8s\n",
+		   "mesh", "tris", "verts", "mode", "cache", "Mtris/s", "peak MB", "ACMR", "ATVR",
+		   "strips", "build", "find", "split", "create", "total");
+	printf("%-14s %8s %8s %-8s %5s %9s %9s %6s %6s %8s %8s %8s %8s %8s %8s\n",
+		   "", "", "", "", "", "", "", "", "", "", "ms", "ms", "ms", "ms", "ms");
+}
+
+// the unprocessed input, for a baseline
+void RunInput(const BenchmarkMesh& mesh, const Settings& settings, unsigned int cacheSize)
+{
+	PrimitiveGroup input;
+	input.type       = PrimType::PT_LIST;
+	input.numIndices = mesh.indices.size();
+	input.indices    = new size_t[mesh.indices.size()];
+	std::copy(std::begin(mesh.indices), std::end(mesh.indices), input.indices);
+
+	StripifyStats stats;
+	CalcStripifyStats(&input, 1, cacheSize, settings.bLRUCache, &stats);
+
+	printf("%-14s %8zu %8zu %-8s %5u %9s %9s %6.3f %6.3f %8s\n",
+		   mesh.name.c_str(), mesh.NumTriangles(), mesh.NumVertices(), "input", cacheSize,
+		   "", "", stats.acmr, stats.atvr, "");
+}
+
+void RunCase(const BenchmarkMesh& mesh, const Settings& settings, Mode mode, unsigned int cacheSize)
+{
+	StripifyOptions options = MakeOptions(settings, mode, cacheSize);
+
+	StripifyResult result;
+	StripifyTimings best;
+	size_t peak = 0;
+
+	for(unsigned int r = 0; r < settings.numRepeats; r++)
+	{
+		result.Clear();
+
+		//the result's memory is counted from here on, as part of the run
+		size_t before = liveBytes.load();
+		peakBytes.store(before);
+
+		GenerateStrips(options, mesh.indices.data(), mesh.indices.size(), result);
+
+		peak = std::max(peak, peakBytes.load() - before);
+		if( (r == 0) || (result.Timings().total < best.total) )
+			best = result.Timings();
+	}
+
+	StripifyStats stats;
+	CalcStripifyStats(result, cacheSize, settings.bLRUCache, &stats);
+
+	double trisPerSecond = (best.total > 0.0) ? mesh.NumTriangles() / best.total : 0.0;
+	printf("%-14s %8zu %8zu %-8s %5u %9.3f %9.2f %6.3f %6.3f %8zu %8.2f %8.2f %8.2f %8.2f %8.2f\n",
+		   mesh.name.c_str(), mesh.NumTriangles(), mesh.NumVertices(), MODE_NAMES[static_cast<size_t>(mode)], cacheSize,
+		   trisPerSecond / 1.0e6, peak / (1024.0 * 1024.0), stats.acmr, stats.atvr, stats.numStrips,
+		   best.buildStripifyInfo * 1000.0, best.findAllStrips * 1000.0, best.splitUpStripsAndOptimize * 1000.0,
+		   best.createStrips * 1000.0, best.total * 1000.0);
+	fflush(stdout);
+}
+
+}  // namespace
+
+}  // namespace nv::tristrip::benchmark
+
+
+int main(int argc, char** argv)
+{
+	using namespace nv::tristrip::benchmark;
+
+	Settings settings;
+	if(!ParseArgs(argc, argv, settings))
+		return 1;
+
+	std::vector<BenchmarkMesh> meshes;
+	if(settings.bSynthetic)
+		meshes = MakeSyntheticMeshes(settings.scale);
+
+	for(auto fileName : settings.files)
+	{
+		BenchmarkMesh mesh;
+		if(!LoadMesh(fileName, mesh))
+			return 1;
+		meshes.emplace_back(std::move(mesh));
+	}
+
+	if(meshes.empty())
+	{
+		fprintf(stderr, "no meshes to run\n");
+		return 1;
+	}
+
+	PrintHeader();
+	for(auto &mesh : meshes)
+	{
+		for(auto cacheSize : settings.cacheSizes)
+		{
+			RunInput(mesh, settings, cacheSize);
+			for(auto mode : settings.modes)
+				RunCase(mesh, settings, mode, cacheSize);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,560 @@
+#include "MeshCorpus.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+namespace nv::tristrip::benchmark {
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+size_t Scaled(size_t count, float scale)
+{
+	return std::max<size_t>(1, static_cast<size_t>(std::lround(count * scale)));
+}
+
+uint32_t AddVertex(BenchmarkMesh& mesh, float x, float y, float z)
+{
+	mesh.positions.insert(mesh.positions.end(), {x, y, z});
+	return static_cast<uint32_t>(mesh.NumVertices() - 1);
+}
+
+void AddTriangle(BenchmarkMesh& mesh, uint32_t v0, uint32_t v1, uint32_t v2)
+{
+	mesh.indices.insert(mesh.indices.end(), {v0, v1, v2});
+}
+
+// (columns + 1) x (rows + 1) vertices from first, row major
+void AddQuadGrid(BenchmarkMesh& mesh, uint32_t first, size_t columns, size_t rows)
+{
+	for(size_t y = 0; y < rows; y++)
+	{
+		for(size_t x = 0; x < columns; x++)
+		{
+			uint32_t v00 = first + static_cast<uint32_t>(y * (columns + 1) + x);
+			uint32_t v10 = v00 + 1;
+			uint32_t v01 = v00 + static_cast<uint32_t>(columns + 1);
+			uint32_t v11 = v01 + 1;
+
+			AddTriangle(mesh, v00, v01, v10);
+			AddTriangle(mesh, v10, v01, v11);
+		}
+	}
+}
+
+BenchmarkMesh MakeGrid(float scale)
+{
+	BenchmarkMesh mesh;
+	mesh.name = "grid";
+
+	size_t side = Scaled(128, std::sqrt(scale));
+	for(size_t y = 0; y <= side; y++)
+	{
+		for(size_t x = 0; x <= side; x++)
+			AddVertex(mesh, (float)x, (float)y, 0.0f);
+	}
+
+	AddQuadGrid(mesh, 0, side, side);
+	return mesh;
+}
+
+BenchmarkMesh MakeSphere(float scale)
+{
+	BenchmarkMesh mesh;
+	mesh.name = "sphere";
+
+	size_t rings    = Scaled(64, std::sqrt(scale));
+	size_t segments = rings * 2;
+
+	uint32_t top = AddVertex(mesh, 0.0f, 0.0f, 1.0f);
+	for(size_t r = 1; r < rings; r++)
+	{
+		float theta = PI * r / rings;
+		for(size_t s = 0; s < segments; s++)
+		{
+			float phi = 2.0f * PI * s / segments;
+			AddVertex(mesh, std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+		}
+	}
+	uint32_t bottom = AddVertex(mesh, 0.0f, 0.0f, -1.0f);
+
+	auto ringVertex = [segments](size_t r, size_t s) {
+		return static_cast<uint32_t>(1 + (r - 1) * segments + (s % segments));
+	};
+
+	for(size_t s = 0; s < segments; s++)
+		AddTriangle(mesh, top, ringVertex(1, s), ringVertex(1, s + 1));
+
+	for(size_t r = 1; r + 1 < rings; r++)
+	{
+		for(size_t s = 0; s < segments; s++)
+		{
+			AddTriangle(mesh, ringVertex(r, s), ringVertex(r + 1, s), ringVertex(r, s + 1));
+			AddTriangle(mesh, ringVertex(r, s + 1), ringVertex(r + 1, s), ringVertex(r + 1, s + 1));
+		}
+	}
+
+	for(size_t s = 0; s < segments; s++)
+		AddTriangle(mesh, bottom, ringVertex(rings - 1, s + 1), ringVertex(rings - 1, s));
+
+	return mesh;
+}
+
+BenchmarkMesh MakeFans(float scale)
+{
+	BenchmarkMesh mesh;
+	mesh.name = "fan";
+
+	//discs whose centre is shared by every triangle of the inner ring
+	const size_t numDiscs = 2;
+	size_t spokes = Scaled(1024, scale);
+	const size_t rings = 4;
+
+	for(size_t d = 0; d < numDiscs; d++)
+	{
+		float cx = 3.0f * d;
+		uint32_t centre = AddVertex(mesh, cx, 0.0f, 0.0f);
+		uint32_t first = static_cast<uint32_t>(mesh.NumVertices());
+
+		for(size_t r = 1; r <= rings; r++)
+		{
+			for(size_t s = 0; s <= spokes; s++)
+			{
+				float phi = 2.0f * PI * s / spokes;
+				AddVertex(mesh, cx + std::cos(phi) * r / rings, std::sin(phi) * r / rings, 0.0f);
+			}
+		}
+
+		for(size_t s = 0; s < spokes; s++)
+			AddTriangle(mesh, centre, first + static_cast<uint32_t>(s + 1), first + static_cast<uint32_t>(s));
+
+		AddQuadGrid(mesh, first, spokes, rings - 1);
+	}
+
+	return mesh;
+}
+
+BenchmarkMesh MakeNonManifold(float scale)
+{
+	BenchmarkMesh mesh;
+	mesh.name = "nonmanifold";
+
+	//books of pages, every page a strip of quads starting on the same spine edge
+	size_t numBooks = Scaled(32, scale);
+	const size_t numPages = 8;
+	const size_t pageLength = 16;
+
+	std::mt19937 rng(1234);
+	for(size_t b = 0; b < numBooks; b++)
+	{
+		float bx = 2.0f * b;
+		uint32_t spine0 = AddVertex(mesh, bx, 0.0f, 0.0f);
+		uint32_t spine1 = AddVertex(mesh, bx, 1.0f, 0.0f);
+
+		for(size_t p = 0; p < numPages; p++)
+		{
+			float angle = 2.0f * PI * p / numPages;
+			uint32_t prev0 = spine0, prev1 = spine1;
+			for(size_t i = 1; i <= pageLength; i++)
+			{
+				float dist = (float)i / pageLength;
+				uint32_t next0 = AddVertex(mesh, bx + std::cos(angle) * dist, 0.0f, std::sin(angle) * dist);
+				uint32_t next1 = AddVertex(mesh, bx + std::cos(angle) * dist, 1.0f, std::sin(angle) * dist);
+
+				AddTriangle(mesh, prev0, prev1, next0);
+				AddTriangle(mesh, next0, prev1, next1);
+				prev0 = next0;
+				prev1 = next1;
+			}
+		}
+	}
+
+	//and some faces repeated, a few of them flipped
+	size_t numFaces = mesh.NumTriangles();
+	for(size_t i = 0; i < numFaces / 16; i++)
+	{
+		size_t f = rng() % numFaces;
+		uint32_t v0 = mesh.indices[f * 3 + 0], v1 = mesh.indices[f * 3 + 1], v2 = mesh.indices[f * 3 + 2];
+		if(i % 4 == 0)
+			AddTriangle(mesh, v0, v2, v1);
+		else
+			AddTriangle(mesh, v0, v1, v2);
+	}
+
+	return mesh;
+}
+
+BenchmarkMesh MakeSoup(float scale)
+{
+	BenchmarkMesh mesh;
+	mesh.name = "soup";
+
+	size_t numTriangles = Scaled(16384, scale);
+	size_t numVertices = numTriangles / 2 + 3;
+
+	std::mt19937 rng(5678);
+	std::uniform_real_distribution<float> coord(0.0f, 1.0f);
+	for(size_t v = 0; v < numVertices; v++)
+		AddVertex(mesh, coord(rng), coord(rng), coord(rng));
+
+	while(mesh.NumTriangles() < numTriangles)
+	{
+		uint32_t v0 = rng() % numVertices, v1 = rng() % numVertices, v2 = rng() % numVertices;
+		if( (v0 != v1) && (v0 != v2) && (v1 != v2) )
+			AddTriangle(mesh, v0, v1, v2);
+	}
+
+	return mesh;
+}
+
+struct FileCloser
+{
+	void operator()(FILE* file) const { fclose(file); }
+};
+using FilePtr = std::unique_ptr<FILE, FileCloser>;
+
+// adds the polygon as a fan, indices as read from the file
+void AddPolygon(BenchmarkMesh& mesh, const std::vector<uint32_t>& polygon)
+{
+	for(size_t i = 2; i < polygon.size(); i++)
+		AddTriangle(mesh, polygon[0], polygon[i - 1], polygon[i]);
+}
+
+bool LoadObj(FILE* file, const char* fileName, BenchmarkMesh& mesh)
+{
+	char line[4096];
+	std::vector<uint32_t> polygon;
+	size_t lineNumber = 0;
+
+	while(fgets(line, sizeof(line), file) != nullptr)
+	{
+		++lineNumber;
+		if( (line[0] == 'v') && (line[1] == ' ') )
+		{
+			float x = 0.0f, y = 0.0f, z = 0.0f;
+			if(sscanf(line + 2, "%f %f %f", &x, &y, &z) < 3)
+			{
+				fprintf(stderr, "%s:%zu: bad vertex\n", fileName, lineNumber);
+				return false;
+			}
+			AddVertex(mesh, x, y, z);
+		}
+		else if( (line[0] == 'f') && (line[1] == ' ') )
+		{
+			polygon.clear();
+
+			char* cursor = line + 2;
+			while(true)
+			{
+				char* end = nullptr;
+				long index = strtol(cursor, &end, 10);
+				if(end == cursor)
+					break;
+
+				//negative indices count back from the last vertex
+				long vertex = (index < 0) ? static_cast<long>(mesh.NumVertices()) + index : index - 1;
+				if( (vertex < 0) || (static_cast<size_t>(vertex) >= mesh.NumVertices()) )
+				{
+					fprintf(stderr, "%s:%zu: face uses a vertex which isn't there\n", fileName, lineNumber);
+					return false;
+				}
+				polygon.emplace_back(static_cast<uint32_t>(vertex));
+
+				//skip the texture coordinate and normal indices
+				cursor = end;
+				while( (*cursor != '\0') && (*cursor != ' ') && (*cursor != '\t') )
+					++cursor;
+			}
+
+			AddPolygon(mesh, polygon);
+		}
+	}
+
+	return true;
+}
+
+// Value types a PLY property can have, and how to read them
+struct PlyType
+{
+	const char* names[2];
+	size_t size;
+	bool bSigned;
+	bool bFloat;
+};
+
+const PlyType PLY_TYPES[] = {
+	{{"char",   "int8"},    1, true,  false},
+	{{"uchar",  "uint8"},   1, false, false},
+	{{"short",  "int16"},   2, true,  false},
+	{{"ushort", "uint16"},  2, false, false},
+	{{"int",    "int32"},   4, true,  false},
+	{{"uint",   "uint32"},  4, false, false},
+	{{"float",  "float32"}, 4, true,  true},
+	{{"double", "float64"}, 8, true,  true},
+};
+
+const PlyType* FindPlyType(const char* name)
+{
+	for(auto &type : PLY_TYPES)
+	{
+		if( (strcmp(name, type.names[0]) == 0) || (strcmp(name, type.names[1]) == 0) )
+			return &type;
+	}
+	return nullptr;
+}
+
+struct PlyProperty
+{
+	std::string name;
+	const PlyType* type = nullptr;
+	const PlyType* countType = nullptr;  // lists only
+};
+
+struct PlyElement
+{
+	std::string name;
+	size_t count = 0;
+	std::vector<PlyProperty> properties;
+};
+
+enum class PlyFormat
+{
+	ASCII,
+	BINARY_LE,
+	BINARY_BE
+};
+
+bool ReadPlyValue(FILE* file, PlyFormat format, const PlyType& type, double& value)
+{
+	if(format == PlyFormat::ASCII)
+		return fscanf(file, "%lf", &value) == 1;
+
+	unsigned char bytes[8];
+	if(fread(bytes, type.size, 1, file) != 1)
+		return false;
+
+	bool bHostLittle = true;
+	{
+		const uint16_t probe = 1;
+		unsigned char first;
+		memcpy(&first, &probe, 1);
+		bHostLittle = (first == 1);
+	}
+	if( bHostLittle != (format == PlyFormat::BINARY_LE) )
+		std::reverse(bytes, bytes + type.size);
+
+	if(type.bFloat)
+	{
+		if(type.size == 4)
+		{
+			float f;
+			memcpy(&f, bytes, 4);
+			value = f;
+		}
+		else
+			memcpy(&value, bytes, 8);
+		return true;
+	}
+
+	uint64_t bits = 0;
+	memcpy(&bits, bytes, type.size);  // host order, low bytes first on little endian hosts
+	if(!bHostLittle)
+		bits >>= (8 - type.size) * 8;
+
+	if(type.bSigned && (type.size < 8) && (bits & (uint64_t{1} << (type.size * 8 - 1))))
+		bits |= ~uint64_t{0} << (type.size * 8);
+
+	value = type.bSigned ? (double)static_cast<int64_t>(bits) : (double)bits;
+	return true;
+}
+
+bool LoadPly(FILE* file, const char* fileName, BenchmarkMesh& mesh)
+{
+	char line[1024];
+	if( (fgets(line, sizeof(line), file) == nullptr) || (strncmp(line, "ply", 3) != 0) )
+	{
+		fprintf(stderr, "%s: not a PLY file\n", fileName);
+		return false;
+	}
+
+	PlyFormat format = PlyFormat::ASCII;
+	std::vector<PlyElement> elements;
+
+	while(true)
+	{
+		if(fgets(line, sizeof(line), file) == nullptr)
+		{
+			fprintf(stderr, "%s: header doesn't end\n", fileName);
+			return false;
+		}
+
+		char word[3][256];
+		int numWords = sscanf(line, "%255s %255s %255s", word[0], word[1], word[2]);
+		if(numWords <= 0)
+			continue;
+
+		if(strcmp(word[0], "end_header") == 0)
+			break;
+
+		if( (strcmp(word[0], "format") == 0) && (numWords >= 2) )
+		{
+			if(strcmp(word[1], "binary_little_endian") == 0)
+				format = PlyFormat::BINARY_LE;
+			else if(strcmp(word[1], "binary_big_endian") == 0)
+				format = PlyFormat::BINARY_BE;
+		}
+		else if( (strcmp(word[0], "element") == 0) && (numWords >= 3) )
+		{
+			PlyElement element;
+			element.name = word[1];
+			element.count = strtoull(word[2], nullptr, 10);
+			elements.emplace_back(element);
+		}
+		else if( (strcmp(word[0], "property") == 0) && !elements.empty() )
+		{
+			PlyProperty property;
+			if(strcmp(word[1], "list") == 0)
+			{
+				char itemType[256], name[256];
+				if(sscanf(line, "%*s %*s %255s %255s %255s", word[2], itemType, name) != 3)
+				{
+					fprintf(stderr, "%s: bad list property\n", fileName);
+					return false;
+				}
+				property.countType = FindPlyType(word[2]);
+				property.type = FindPlyType(itemType);
+				property.name = name;
+				if(property.countType == nullptr)
+					property.type = nullptr;
+			}
+			else if(numWords >= 3)
+			{
+				property.type = FindPlyType(word[1]);
+				property.name = word[2];
+			}
+
+			if(property.type == nullptr)
+			{
+				fprintf(stderr, "%s: unknown property type\n", fileName);
+				return false;
+			}
+			elements.back().properties.emplace_back(property);
+		}
+	}
+
+	std::vector<uint32_t> polygon;
+	for(auto &element : elements)
+	{
+		bool bVertices = (element.name == "vertex");
+		bool bFaces    = (element.name == "face");
+
+		for(size_t i = 0; i < element.count; i++)
+		{
+			float position[3] = {0.0f, 0.0f, 0.0f};
+			polygon.clear();
+
+			for(auto &property : element.properties)
+			{
+				double value = 0.0;
+				if(property.countType != nullptr)
+				{
+					if(!ReadPlyValue(file, format, *property.countType, value))
+					{
+						fprintf(stderr, "%s: file ends early\n", fileName);
+						return false;
+					}
+
+					size_t count = static_cast<size_t>(value);
+					bool bIndices = bFaces && ( (property.name == "vertex_indices") || (property.name == "vertex_index") );
+					for(size_t c = 0; c < count; c++)
+					{
+						if(!ReadPlyValue(file, format, *property.type, value))
+						{
+							fprintf(stderr, "%s: file ends early\n", fileName);
+							return false;
+						}
+						if(bIndices)
+							polygon.emplace_back(static_cast<uint32_t>(value));
+					}
+					continue;
+				}
+
+				if(!ReadPlyValue(file, format, *property.type, value))
+				{
+					fprintf(stderr, "%s: file ends early\n", fileName);
+					return false;
+				}
+
+				if(bVertices && (property.name.size() == 1) && (property.name[0] >= 'x') && (property.name[0] <= 'z'))
+					position[property.name[0] - 'x'] = static_cast<float>(value);
+			}
+
+			if(bVertices)
+				AddVertex(mesh, position[0], position[1], position[2]);
+			else if(bFaces)
+			{
+				for(auto v : polygon)
+				{
+					if(v >= mesh.NumVertices())
+					{
+						fprintf(stderr, "%s: face uses a vertex which isn't there\n", fileName);
+						return false;
+					}
+				}
+				AddPolygon(mesh, polygon);
+			}
+		}
+	}
+
+	return true;
+}
+
+}  // namespace
+
+
+std::vector<BenchmarkMesh> MakeSyntheticMeshes(float scale)
+{
+	std::vector<BenchmarkMesh> meshes;
+	meshes.emplace_back(MakeGrid(scale));
+	meshes.emplace_back(MakeSphere(scale));
+	meshes.emplace_back(MakeFans(scale));
+	meshes.emplace_back(MakeNonManifold(scale));
+	meshes.emplace_back(MakeSoup(scale));
+	return meshes;
+}
+
+
+bool LoadMesh(const char* fileName, BenchmarkMesh& mesh)
+{
+	mesh = BenchmarkMesh();
+
+	const char* baseName = strrchr(fileName, '/');
+	mesh.name = (baseName != nullptr) ? baseName + 1 : fileName;
+
+	FilePtr file(fopen(fileName, "rb"));
+	if(file == nullptr)
+	{
+		fprintf(stderr, "%s: can't open\n", fileName);
+		return false;
+	}
+
+	size_t length = strlen(fileName);
+	bool bPly = (length >= 4) && ( (strcmp(fileName + length - 4, ".ply") == 0) || (strcmp(fileName + length - 4, ".PLY") == 0) );
+
+	bool bLoaded = bPly ? LoadPly(file.get(), fileName, mesh) : LoadObj(file.get(), fileName, mesh);
+	if(bLoaded && mesh.indices.empty())
+	{
+		fprintf(stderr, "%s: no faces\n", fileName);
+		return false;
+	}
+
+	return bLoaded;
+}
+
+}  // namespace nv::tristrip::benchmark
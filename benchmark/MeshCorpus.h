@@ -0,0 +1,36 @@
+#ifndef NV_BENCHMARK_MESH_CORPUS_H
+#define NV_BENCHMARK_MESH_CORPUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nv::tristrip::benchmark {
+
+// An indexed triangle list to stripify, positions are x, y, z per vertex
+struct BenchmarkMesh
+{
+	std::string name;
+	std::vector<float> positions;
+	std::vector<uint32_t> indices;
+
+	size_t NumVertices() const { return positions.size() / 3; }
+	size_t NumTriangles() const { return indices.size() / 3; }
+};
+
+// The synthetic meshes, scale multiplies their triangle counts, roughly
+//  grid:        regular grid of quads, the best case for strips
+//  sphere:      latitude/longitude sphere, with fans closing off the poles
+//  fan:         a few very high valence vertices, like terrain caps
+//  nonmanifold: fins sharing edges with three and more faces, and repeated faces
+//  soup:        random triangles, no adjacency to speak of
+std::vector<BenchmarkMesh> MakeSyntheticMeshes(float scale);
+
+// Reads a Wavefront OBJ, or ASCII or binary PLY, file.  Polygons are split into fans.
+// Returns false and prints why on failure.
+bool LoadMesh(const char* fileName, BenchmarkMesh& mesh);
+
+}  // namespace nv::tristrip::benchmark
+
+#endif